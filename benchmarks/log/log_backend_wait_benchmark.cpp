@@ -0,0 +1,111 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * Hand over latency and idle CPU cost of the backend wait strategies.
+ *
+ * The latency case pushes one record at a time and waits until the backend
+ * has written it. The idle case pushes a record every millisecond and
+ * reports the CPU time the process used meanwhile, which is mostly the
+ * backend waiting. Pin the backend to an isolated core for the SPIN figures
+ * to mean anything.
+ */
+
+#include "log/log_backend.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+using namespace SN;
+
+namespace {
+
+constexpr int kLatencyIterations = 20000;
+constexpr int kIdleIterations = 200;
+
+using Clock_TP = std::chrono::steady_clock;
+
+Log::PushResult_TP Push(Log::LogBackend_C& backend) {
+    static const Log::OverflowSettings_TP kOverflow{
+        Log::OverflowPolicy_TP::BLOCK, Log::LogSeverityLevel_TP::LOG_INFO,
+        std::chrono::milliseconds(1000)};
+    Log::LogRecord_TP record;
+    record.m_level = Log::LogSeverityLevel_TP::LOG_INFO;
+    record.m_message = "tick";
+    return backend.Push(record, kOverflow);
+}
+
+void Run(const char* name, Log::BackendWaitStrategy_TP strategy) {
+    Log::BackendThreadSettings_TP settings;
+    settings.m_wait = strategy;
+    std::atomic<uint64_t> written(0);
+    Log::LogBackend_C backend(
+        1024,
+        [&written](std::vector<Log::LogRecord_TP>& batch) {
+            written.fetch_add(batch.size(), std::memory_order_release);
+        },
+        Log::LogBackend_C::SyncOutputs_TP(), settings);
+
+    std::vector<double> latencies;
+    latencies.reserve(kLatencyIterations);
+    for (int i = 0; i < kLatencyIterations; ++i) {
+        uint64_t target = written.load(std::memory_order_acquire) + 1;
+        auto start = Clock_TP::now();
+        Push(backend);
+        while (written.load(std::memory_order_acquire) < target) {
+        }
+        latencies.push_back(static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock_TP::now() - start)
+                .count()));
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::clock_t cpu_start = std::clock();
+    for (int i = 0; i < kIdleIterations; ++i) {
+        Push(backend);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double cpu_ms = 1000.0 * static_cast<double>(std::clock() - cpu_start) /
+                    CLOCKS_PER_SEC;
+    backend.Stop();
+
+    std::printf("%-12s median %8.1f ns  p99 %9.1f ns  idle cpu %6.1f ms\n",
+                name, latencies[latencies.size() / 2],
+                latencies[latencies.size() * 99 / 100], cpu_ms);
+}
+
+}  // namespace
+
+int main() {
+    Run("BLOCK", Log::BackendWaitStrategy_TP::BLOCK);
+    Run("PARK", Log::BackendWaitStrategy_TP::PARK);
+    Run("SPIN_YIELD", Log::BackendWaitStrategy_TP::SPIN_YIELD);
+    Run("SPIN", Log::BackendWaitStrategy_TP::SPIN);
+    return 0;
+}
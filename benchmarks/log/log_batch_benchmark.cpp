@@ -0,0 +1,89 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * Replaying pre-built records into a log file, one SN_LOG per record
+ * against Logger_C::WriteBatch().
+ */
+
+#include "log/logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace SN;
+
+namespace {
+
+constexpr size_t kRecords = 1000000;
+constexpr size_t kBatchSize = 4096;
+
+double NsPerRecord(std::chrono::steady_clock::duration elapsed) {
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                   .count()) /
+           kRecords;
+}
+
+}  // namespace
+
+int main() {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->Init("log_batch_benchmark.log");
+    logger->SetTimeStampMode(Log::TimeStampMode_TP::EPOCH_MICRO_SECONDS);
+
+    std::vector<std::string> messages(kBatchSize);
+    std::vector<Log::LogRecord_TP> records(kBatchSize);
+    for (size_t i = 0; i < kBatchSize; ++i) {
+        messages[i] =
+            "wheel speed " + std::to_string(static_cast<double>(i) / 2);
+        records[i].m_level = Log::LogSeverityLevel_TP::LOG_INFO;
+        records[i].m_file = "controller.c";
+        records[i].m_function = "Step";
+        records[i].m_line = 42;
+        records[i].m_message = messages[i];
+        records[i].m_time =
+            Log::LogTimePoint_TP::FromEpochNs(1700000000000000000 +
+                                              static_cast<int64_t>(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kRecords; ++i) {
+        SN_LOG_INFO << messages[i % kBatchSize];
+    }
+    logger->FlushOut();
+    std::printf("%-32s %8.1f ns\n", "replay: SN_LOG per record",
+                NsPerRecord(std::chrono::steady_clock::now() - start));
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kRecords; i += kBatchSize) {
+        logger->WriteBatch(records.data(), kBatchSize);
+    }
+    logger->FlushOut();
+    std::printf("%-32s %8.1f ns\n", "replay: WriteBatch",
+                NsPerRecord(std::chrono::steady_clock::now() - start));
+    return 0;
+}
@@ -0,0 +1,91 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * Caller side cost of SN_LOG, i.e. the site check, the message sink and the
+ * hand over to the logger.
+ *
+ * Build the library once with and once without ENABLE_LOG_UNITY_BUILD to see
+ * what the calls across translation units cost.
+ */
+
+#include "log/logger.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace SN;
+
+namespace {
+
+constexpr int kIterations = 1000000;
+
+template <typename Body_TP>
+void Run(const char* name, Body_TP body) {
+    // Warm up caches and the record pool
+    for (int i = 0; i < kIterations / 10; ++i) {
+        body(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        body(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed)
+                        .count()) /
+                kIterations;
+    std::printf("%-32s %8.1f ns\n", name, ns);
+}
+
+}  // namespace
+
+int main() {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+    logger->SetFlushLevel(Log::LogSeverityLevel_TP::LOG_FATAL);
+    logger->Init("/dev/null");
+    logger->Prepare();
+
+    Run("disabled level", [](int i) { SN_LOG_DEBUG << "tick " << i; });
+    // Formats and builds the record, which Submit() then rejects, so this
+    // is the message path without any output
+    Run("message sink only", [](int i) {
+        Log::LogMessageShink_C(Log::LogSeverityLevel_TP::LOG_DEBUG, __FILE__,
+                               __FUNCTION_NAME__, __LINE__)
+                .GetStream()
+            << "tick " << i;
+    });
+    Run("sync message", [](int i) { SN_LOG_INFO << "tick " << i; });
+
+    // The caller only formats and queues, records that find the queue full
+    // are dropped
+    logger->SetOverflowPolicy(Log::OverflowPolicy_TP::DROP_NEWEST);
+    logger->EnableAsyncLogging(1 << 16);
+    logger->PrepareThread();
+    Run("async message", [](int i) { SN_LOG_INFO << "tick " << i; });
+    logger->DisableAsyncLogging();
+    return 0;
+}
@@ -0,0 +1,76 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * Latency of the first messages of a fresh thread, with and without
+ * Logger_C::PrepareThread().
+ */
+
+#include "log/logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace SN;
+
+namespace {
+
+constexpr int kMessages = 4;
+
+/** Logs from a new thread and prints the latency of each message */
+void MeasureThread(const char* label, bool prepare) {
+    std::thread worker([label, prepare] {
+        if (prepare) {
+            Log::Logger_C::GetInstance()->PrepareThread();
+        }
+        double latency_ns[kMessages];
+        for (int i = 0; i < kMessages; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            SN_LOG_INFO << "control tick " << i << " value " << 0.25 * i;
+            latency_ns[i] = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+        }
+        std::printf("%-24s", label);
+        for (double latency : latency_ns) {
+            std::printf(" %10.0f ns", latency);
+        }
+        std::printf("\n");
+    });
+    worker.join();
+}
+
+}  // namespace
+
+int main() {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->Init("log_first_message_benchmark.log");
+    logger->SetFlushLevel(Log::LogSeverityLevel_TP::LOG_ERROR);
+    MeasureThread("cold thread", false);
+    logger->Prepare();
+    MeasureThread("prepared thread", true);
+    return 0;
+}
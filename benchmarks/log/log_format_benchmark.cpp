@@ -0,0 +1,161 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * Microbenchmarks of the formatting kernels against std::ostringstream.
+ *
+ * Every case formats the same operands into a reused buffer, the result is
+ * the mean time per iteration.
+ */
+
+#include "log/log_buffer.h"
+#include "log/log_format_kernels.h"
+#include "log/log_stream.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace SN;
+
+namespace {
+
+constexpr int kIterations = 1000000;
+
+/** Keeps the compiler from dropping the formatted output */
+volatile size_t g_sink = 0;
+
+template <typename Body_TP>
+void Run(const char* name, Body_TP body) {
+    // Warm up caches and the buffer pool
+    for (int i = 0; i < kIterations / 10; ++i) {
+        body(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        body(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed)
+                        .count()) /
+                kIterations;
+    std::printf("%-32s %8.1f ns\n", name, ns);
+}
+
+}  // namespace
+
+int main() {
+    Log::LogBuffer_C buffer;
+    Log::LogStream_C log_stream(buffer);
+    std::ostringstream string_stream;
+
+    Run("int: ostringstream", [&](int i) {
+        string_stream.str(std::string());
+        string_stream << i << ' ' << -i;
+        g_sink = g_sink + string_stream.str().size();
+    });
+    Run("int: LogStream_C", [&](int i) {
+        buffer.Clear();
+        log_stream << i << ' ' << -i;
+        g_sink = g_sink + buffer.Size();
+    });
+    Run("uint64: FormatUnsigned", [&](int i) {
+        char out[Log::Kernels::kMaxIntegerChars];
+        g_sink = g_sink + Log::Kernels::FormatUnsigned(
+                              static_cast<uint64_t>(i) * 2654435761u, out);
+    });
+
+    Run("double: ostringstream", [&](int i) {
+        string_stream.str(std::string());
+        string_stream << i * 0.001;
+        g_sink = g_sink + string_stream.str().size();
+    });
+    Run("double: LogStream_C", [&](int i) {
+        buffer.Clear();
+        log_stream << i * 0.001;
+        g_sink = g_sink + buffer.Size();
+    });
+    Run("fixed(3): LogStream_C", [&](int i) {
+        buffer.Clear();
+        log_stream << Log::Fixed(i * 0.001, 3);
+        g_sink = g_sink + buffer.Size();
+    });
+
+    Run("pointer: ostringstream", [&](int i) {
+        string_stream.str(std::string());
+        string_stream << static_cast<const void*>(&buffer + i);
+        g_sink = g_sink + string_stream.str().size();
+    });
+    Run("pointer: LogStream_C", [&](int i) {
+        buffer.Clear();
+        log_stream << static_cast<const void*>(&buffer + i);
+        g_sink = g_sink + buffer.Size();
+    });
+
+    Run("message: ostringstream", [&](int i) {
+        string_stream.str(std::string());
+        string_stream << "request " << i << " took " << i * 0.25
+                      << " ms, status " << 200;
+        g_sink = g_sink + string_stream.str().size();
+    });
+    Run("message: LogStream_C", [&](int i) {
+        buffer.Clear();
+        log_stream << "request " << i << " took " << i * 0.25
+                   << " ms, status " << 200;
+        g_sink = g_sink + buffer.Size();
+    });
+
+    // A 64 byte sensor packet
+    uint8_t packet[64];
+    for (size_t i = 0; i < sizeof(packet); ++i) {
+        packet[i] = static_cast<uint8_t>(i * 37);
+    }
+    Run("hex(64B): std::hex loop", [&](int i) {
+        packet[0] = static_cast<uint8_t>(i);
+        string_stream.str(std::string());
+        string_stream << std::hex << std::setfill('0');
+        for (uint8_t byte : packet) {
+            string_stream << std::setw(2) << static_cast<int>(byte);
+        }
+        string_stream << std::dec;
+        g_sink = g_sink + string_stream.str().size();
+    });
+    Run("hex(64B): LogStream_C", [&](int i) {
+        packet[0] = static_cast<uint8_t>(i);
+        buffer.Clear();
+        log_stream << Log::HexBytes(packet, sizeof(packet));
+        g_sink = g_sink + buffer.Size();
+    });
+    Run("base64(64B): LogStream_C", [&](int i) {
+        packet[0] = static_cast<uint8_t>(i);
+        buffer.Clear();
+        log_stream << Log::Base64Bytes(packet, sizeof(packet));
+        g_sink = g_sink + buffer.Size();
+    });
+    return 0;
+}
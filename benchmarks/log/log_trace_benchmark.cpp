@@ -0,0 +1,62 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * Cost of a trace span, with recording on and off.
+ */
+
+#include "log/log_trace.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace SN;
+
+namespace {
+
+constexpr int kSpans = 1000000;
+
+double MeasureSpans() {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSpans; ++i) {
+        SN_TRACE_SCOPE("benchmark_span");
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                   .count()) /
+           kSpans;
+}
+
+}  // namespace
+
+int main() {
+    Log::Tracer_C* tracer = Log::Tracer_C::GetInstance();
+    tracer->SetCapacity(2 * kSpans);
+    tracer->Reserve(kSpans);
+    std::printf("%-32s %8.1f ns\n", "span: recording off", MeasureSpans());
+    tracer->Enable();
+    std::printf("%-32s %8.1f ns\n", "span: recording on", MeasureSpans());
+    tracer->Disable();
+    return 0;
+}
@@ -0,0 +1 @@
+#include "../../src/log_backend.h"
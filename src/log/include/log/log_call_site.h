@@ -0,0 +1 @@
+#include "../../src/log_call_site.h"
@@ -0,0 +1 @@
+#include "../../src/log_format_kernels.h"
@@ -0,0 +1 @@
+#include "../../src/log_load_shedder.h"
@@ -0,0 +1 @@
+#include "../../src/log_mapped_file.h"
@@ -0,0 +1 @@
+#include "../../src/log_record_pool.h"
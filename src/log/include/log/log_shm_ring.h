@@ -0,0 +1 @@
+#include "../../src/log_shm_ring.h"
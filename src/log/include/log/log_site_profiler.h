@@ -0,0 +1 @@
+#include "../../src/log_site_profiler.h"
@@ -0,0 +1 @@
+#include "../../src/log_socket_sink.h"
@@ -0,0 +1 @@
+#include "../../src/log_thread_file.h"
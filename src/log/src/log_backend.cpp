@@ -0,0 +1,537 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_backend.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "log_format_kernels.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "the wake word is used as futex word");
+
+/** Tells the core that this is a polling loop */
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+#if defined(__linux__)
+int ToSchedPolicy(BackendSchedPolicy_TP policy) {
+    switch (policy) {
+        case BackendSchedPolicy_TP::FIFO:
+            return SCHED_FIFO;
+        case BackendSchedPolicy_TP::RR:
+            return SCHED_RR;
+        case BackendSchedPolicy_TP::BATCH:
+            return SCHED_BATCH;
+        case BackendSchedPolicy_TP::IDLE:
+            return SCHED_IDLE;
+        default:
+            return SCHED_OTHER;
+    }
+}
+
+uint32_t* FutexWord(std::atomic<uint32_t>& word) {
+    return reinterpret_cast<uint32_t*>(&word);
+}
+#endif
+
+}  // namespace
+
+LogBackend_C::LogBackend_C(size_t capacity, WriteBatch_TP write_batch,
+                           SyncOutputs_TP sync_outputs,
+                           const BackendThreadSettings_TP& thread_settings)
+    : m_capacity(capacity != 0 ? capacity : 1),
+      // Reserve an eighth on top for records above the drop level
+      m_ring_size(m_capacity + m_capacity / 8 + 1),
+      m_count(0),
+      m_pushed(0),
+      m_batch_depth(0),
+      m_stop(false),
+      m_consumer_waiting(false),
+      m_wake_word(0),
+      m_idle_interval_ms(0),
+      m_write_batch(std::move(write_batch)),
+      m_sync_outputs(std::move(sync_outputs)),
+      m_thread_settings(thread_settings) {
+    if (m_thread_settings.m_wake_threshold == 0) {
+        m_thread_settings.m_wake_threshold = 1;
+    }
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        m_dropped[i] = 0;
+        m_reported[i] = 0;
+    }
+    for (Lane_TP& lane : m_lanes) {
+        lane.m_ring.resize(m_ring_size);
+    }
+    m_thread = std::thread(&LogBackend_C::Run, this);
+}
+
+LogBackend_C::~LogBackend_C() { Stop(); }
+
+PushResult_TP LogBackend_C::Push(LogRecord_TP& record,
+                                 const OverflowSettings_TP& overflow) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stop) {
+        return PushResult_TP::STOPPED;
+    }
+    bool reserved = overflow.m_policy == OverflowPolicy_TP::DROP_BELOW_LEVEL &&
+                    overflow.m_level <= record.m_level;
+    size_t limit = reserved ? m_ring_size : m_capacity;
+    if (m_count >= limit) {
+        auto has_room = [this, limit] { return m_count < limit || m_stop; };
+        switch (overflow.m_policy) {
+            case OverflowPolicy_TP::BLOCK:
+                if (!m_not_full.wait_for(lock, overflow.m_block_timeout,
+                                         has_room)) {
+                    CountDrop(record.m_level);
+                    return PushResult_TP::DROPPED;
+                }
+                break;
+            case OverflowPolicy_TP::DROP_NEWEST:
+                CountDrop(record.m_level);
+                return PushResult_TP::DROPPED;
+            case OverflowPolicy_TP::DROP_OLDEST:
+                if (!DropOldest(LaneOf(record.m_level))) {
+                    CountDrop(record.m_level);
+                    return PushResult_TP::DROPPED;
+                }
+                break;
+            case OverflowPolicy_TP::DROP_BELOW_LEVEL:
+                if (!reserved) {
+                    CountDrop(record.m_level);
+                    return PushResult_TP::DROPPED;
+                }
+                // Even the reserve is full, wait for the writer
+                m_not_full.wait(lock, has_room);
+                break;
+        }
+        if (m_stop) {
+            return PushResult_TP::STOPPED;
+        }
+    }
+    size_t lane_index = LaneOf(record.m_level);
+    Lane_TP& lane = m_lanes[lane_index];
+    size_t slot = (lane.m_head + lane.m_count) % m_ring_size;
+    lane.m_ring[slot] = std::move(record);
+    ++lane.m_count;
+    ++lane.m_pushed;
+    ++m_count;
+    ++m_pushed;
+    m_wake_word.fetch_add(1, std::memory_order_release);
+    // Only wake the writer when it sleeps, a busy writer picks the record up
+    // with its next batch anyway. Below the threshold the record waits for
+    // more to come or for the end of the park time.
+    bool wake = m_consumer_waiting &&
+                (m_count >= m_thread_settings.m_wake_threshold ||
+                 lane_index == 0);
+    if (wake) {
+        m_consumer_waiting = false;
+    }
+    lock.unlock();
+    if (wake) {
+        Wake();
+    }
+    return PushResult_TP::QUEUED;
+}
+
+bool LogBackend_C::DropOldest(size_t lane_index) {
+    // An old TRACE record goes before any queued error, but a queued error
+    // never goes for an incoming TRACE record
+    Lane_TP* oldest = nullptr;
+    for (size_t i = kLaneCount; i-- > lane_index;) {
+        if (m_lanes[i].m_count != 0) {
+            oldest = &m_lanes[i];
+            break;
+        }
+    }
+    if (oldest == nullptr) {
+        return false;
+    }
+    LogRecord_TP& record = oldest->m_ring[oldest->m_head];
+    CountDrop(record.m_level);
+    record.m_buffer.Reset();
+    oldest->m_head = (oldest->m_head + 1) % m_ring_size;
+    --oldest->m_count;
+    ++oldest->m_processed;
+    --m_count;
+    return true;
+}
+
+bool LogBackend_C::Reached(const uint64_t (&target)[kLaneCount]) const {
+    for (size_t i = 0; i < kLaneCount; ++i) {
+        if (m_lanes[i].m_processed < target[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LogBackend_C::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint64_t target[kLaneCount];
+    for (size_t i = 0; i < kLaneCount; ++i) {
+        target[i] = m_lanes[i].m_pushed;
+    }
+    // Records below the wake threshold must not wait for the park time
+    if (!Reached(target) && TakeSleeper()) {
+        Wake();
+    }
+    m_processed_changed.wait(lock, [this, &target] { return Reached(target); });
+}
+
+std::future<bool> LogBackend_C::RequestSync(bool durable) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    SyncRequest_TP request{{}, durable, std::promise<bool>()};
+    for (size_t i = 0; i < kLaneCount; ++i) {
+        request.m_target[i] = m_lanes[i].m_pushed;
+    }
+    std::future<bool> result = request.m_result.get_future();
+    if (m_stop) {
+        request.m_result.set_value(false);
+        return result;
+    }
+    m_sync_requests.push_back(std::move(request));
+    bool wake = TakeSleeper();
+    lock.unlock();
+    if (wake) {
+        Wake();
+    }
+    return result;
+}
+
+void LogBackend_C::CompleteSyncs(std::unique_lock<std::mutex>& lock) {
+    size_t ready = 0;
+    bool durable = false;
+    while (ready < m_sync_requests.size() &&
+           Reached(m_sync_requests[ready].m_target)) {
+        durable = durable || m_sync_requests[ready].m_durable;
+        ++ready;
+    }
+    if (ready == 0) {
+        return;
+    }
+    m_ready_syncs.clear();
+    auto ready_end =
+        m_sync_requests.begin() + static_cast<std::ptrdiff_t>(ready);
+    std::move(m_sync_requests.begin(), ready_end,
+              std::back_inserter(m_ready_syncs));
+    m_sync_requests.erase(m_sync_requests.begin(), ready_end);
+    // One sync for every request whose records are out
+    lock.unlock();
+    bool result = !m_sync_outputs || m_sync_outputs(durable);
+    for (SyncRequest_TP& request : m_ready_syncs) {
+        request.m_result.set_value(result);
+    }
+    m_ready_syncs.clear();
+    lock.lock();
+}
+
+bool LogBackend_C::TakeSleeper() {
+    m_wake_word.fetch_add(1, std::memory_order_release);
+    bool wake = m_consumer_waiting;
+    m_consumer_waiting = false;
+    return wake;
+}
+
+void LogBackend_C::Wake() {
+#if defined(__linux__)
+    if (m_thread_settings.m_wait == BackendWaitStrategy_TP::PARK) {
+        syscall(SYS_futex, FutexWord(m_wake_word), FUTEX_WAKE_PRIVATE, 1,
+                nullptr, nullptr, 0);
+        return;
+    }
+#endif
+    m_not_empty.notify_one();
+}
+
+void LogBackend_C::Sleep(std::unique_lock<std::mutex>& lock,
+                         std::chrono::nanoseconds timeout) {
+    BackendWaitStrategy_TP wait = m_thread_settings.m_wait;
+    if (wait == BackendWaitStrategy_TP::SPIN ||
+        wait == BackendWaitStrategy_TP::SPIN_YIELD) {
+        // Producers never have to wake a poller, m_consumer_waiting stays
+        // false
+        uint32_t seen = m_wake_word.load(std::memory_order_relaxed);
+        lock.unlock();
+        auto start = std::chrono::steady_clock::now();
+        bool yield = wait == BackendWaitStrategy_TP::SPIN_YIELD;
+        while (m_wake_word.load(std::memory_order_acquire) == seen) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            if (timeout.count() != 0 && elapsed >= timeout) {
+                break;
+            }
+            if (yield && elapsed >= m_thread_settings.m_spin_time) {
+                std::this_thread::yield();
+            } else {
+                CpuRelax();
+            }
+        }
+        lock.lock();
+        return;
+    }
+    m_consumer_waiting = true;
+#if defined(__linux__)
+    if (wait == BackendWaitStrategy_TP::PARK) {
+        // A producer changes the word under the lock, so a change after the
+        // unlock makes the futex return at once and no wake up is lost
+        uint32_t seen = m_wake_word.load(std::memory_order_relaxed);
+        lock.unlock();
+        struct timespec time_out;
+        time_out.tv_sec = timeout.count() / 1000000000;
+        time_out.tv_nsec = timeout.count() % 1000000000;
+        syscall(SYS_futex, FutexWord(m_wake_word), FUTEX_WAIT_PRIVATE, seen,
+                timeout.count() != 0 ? &time_out : nullptr, nullptr, 0);
+        lock.lock();
+        return;
+    }
+#endif
+    if (timeout.count() == 0) {
+        m_not_empty.wait(lock);
+    } else {
+        m_not_empty.wait_for(lock, timeout);
+    }
+}
+
+void LogBackend_C::SetupThread() {
+#if defined(__linux__)
+    const BackendThreadSettings_TP& settings = m_thread_settings;
+    if (!settings.m_name.empty()) {
+        // The kernel keeps 15 characters and rejects longer names
+        std::string name = settings.m_name.substr(0, 15);
+        pthread_setname_np(pthread_self(), name.c_str());
+    }
+    if (!settings.m_cpus.empty()) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : settings.m_cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(static_cast<size_t>(cpu), &cpus);
+            }
+        }
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error != 0) {
+            std::cerr << "[ERROR] : Couldn't set the CPU affinity of the log "
+                         "backend thread: "
+                      << std::strerror(error) << std::endl;
+        }
+    }
+    if (settings.m_policy != BackendSchedPolicy_TP::INHERIT) {
+        int policy = ToSchedPolicy(settings.m_policy);
+        struct sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        if (policy == SCHED_FIFO || policy == SCHED_RR) {
+            param.sched_priority = settings.m_priority;
+        }
+        int error = pthread_setschedparam(pthread_self(), policy, &param);
+        if (error != 0) {
+            std::cerr << "[ERROR] : Couldn't set the scheduling policy of the "
+                         "log backend thread: "
+                      << std::strerror(error) << std::endl;
+        }
+    }
+#endif
+}
+
+void LogBackend_C::Stop() {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        wake = TakeSleeper();
+    }
+    if (wake) {
+        Wake();
+    }
+    m_not_full.notify_all();
+    if (m_thread.joinable() &&
+        m_thread.get_id() != std::this_thread::get_id()) {
+        m_thread.join();
+    }
+}
+
+uint64_t LogBackend_C::GetDroppedCount(LogSeverityLevel_TP level) const {
+    return m_dropped[static_cast<size_t>(level) % kLevelCount].load(
+        std::memory_order_relaxed);
+}
+
+void LogBackend_C::CountDrop(LogSeverityLevel_TP level) {
+    m_dropped[static_cast<size_t>(level) % kLevelCount].fetch_add(
+        1, std::memory_order_relaxed);
+}
+
+bool LogBackend_C::ReportDrops(std::vector<LogRecord_TP>& batch) {
+    uint64_t dropped[kLevelCount];
+    uint64_t total = 0;
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        uint64_t count = m_dropped[i].load(std::memory_order_relaxed);
+        dropped[i] = count - m_reported[i];
+        m_reported[i] = count;
+        total += dropped[i];
+    }
+    if (total == 0) {
+        return false;
+    }
+    LogRecord_TP record;
+    record.m_level = LogSeverityLevel_TP::LOG_WARN;
+    record.m_file = __FILE__;
+    record.m_function = __func__;
+    record.m_line = __LINE__;
+    record.m_time = LogClock_C::GetInstance()->Now();
+    char number[Kernels::kMaxIntegerChars];
+    record.m_buffer.Append("Dropped ");
+    record.m_buffer.Append(number, Kernels::FormatUnsigned(total, number));
+    record.m_buffer.Append(" log records under overload (");
+    const char* separator = "";
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        if (dropped[i] != 0) {
+            record.m_buffer.Append(separator);
+            record.m_buffer.Append(
+                ToString(static_cast<LogSeverityLevel_TP>(i)));
+            record.m_buffer.Append(": ");
+            record.m_buffer.Append(
+                number, Kernels::FormatUnsigned(dropped[i], number));
+            separator = ", ";
+        }
+    }
+    record.m_buffer.Append(')');
+    record.m_message = record.m_buffer.View();
+    batch.push_back(std::move(record));
+    return true;
+}
+
+void LogBackend_C::Run() {
+    SetupThread();
+    // Sleeping with records below the wake threshold queued is bounded
+    bool bounded = m_thread_settings.m_wake_threshold > 1 &&
+                   (m_thread_settings.m_wait == BackendWaitStrategy_TP::BLOCK ||
+                    m_thread_settings.m_wait == BackendWaitStrategy_TP::PARK);
+    std::chrono::nanoseconds max_park = m_thread_settings.m_max_park;
+    if (max_park.count() <= 0) {
+        max_park = std::chrono::microseconds(1);
+    }
+    std::vector<LogRecord_TP> batch;
+    batch.reserve(kMaxBatchRecords + 1);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        CompleteSyncs(lock);
+        bool waiting = false;
+        std::chrono::steady_clock::time_point idle_since;
+        while (m_count == 0 && !m_stop && m_sync_requests.empty()) {
+            std::chrono::milliseconds idle(
+                m_idle_interval_ms.load(std::memory_order_relaxed));
+            if (!waiting && idle.count() != 0) {
+                waiting = true;
+                idle_since = std::chrono::steady_clock::now();
+            }
+            std::chrono::nanoseconds timeout = idle;
+            if (bounded && (timeout.count() == 0 || max_park < timeout)) {
+                timeout = max_park;
+            }
+            Sleep(lock, timeout);
+            if (idle.count() != 0 && m_count == 0 && !m_stop &&
+                m_sync_requests.empty()) {
+                auto now = std::chrono::steady_clock::now();
+                if (now - idle_since >= idle) {
+                    // Idle tick, the batch is empty here
+                    idle_since = now;
+                    m_consumer_waiting = false;
+                    m_batch_depth = 0;
+                    lock.unlock();
+                    m_write_batch(batch);
+                    lock.lock();
+                }
+            }
+        }
+        m_consumer_waiting = false;
+        if (m_count == 0) {
+            if (!m_sync_requests.empty()) {
+                // Nothing queued before the barrier is left
+                continue;
+            }
+            // Stopped and drained
+            break;
+        }
+        // Highest lane first, a record arriving in a higher lane meanwhile
+        // waits for this batch only
+        m_batch_depth = m_count;
+        size_t taken[kLaneCount] = {};
+        for (size_t i = 0; i < kLaneCount && batch.size() < kMaxBatchRecords;
+             ++i) {
+            Lane_TP& lane = m_lanes[i];
+            while (lane.m_count != 0 && batch.size() < kMaxBatchRecords) {
+                batch.push_back(std::move(lane.m_ring[lane.m_head]));
+                lane.m_head = (lane.m_head + 1) % m_ring_size;
+                --lane.m_count;
+                --m_count;
+                ++taken[i];
+            }
+        }
+        lock.unlock();
+        m_not_full.notify_all();
+
+        m_write_batch(batch);
+        batch.clear();
+
+        lock.lock();
+        for (size_t i = 0; i < kLaneCount; ++i) {
+            m_lanes[i].m_processed += taken[i];
+        }
+        m_processed_changed.notify_all();
+        // The backlog is cleared, tell what has been lost on the way
+        if (m_count == 0) {
+            lock.unlock();
+            if (ReportDrops(batch)) {
+                m_write_batch(batch);
+                batch.clear();
+            }
+            lock.lock();
+        }
+    }
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,315 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_backend.h
+ *
+ * @brief LogBackend_C queues log records and writes them out on a background
+ * thread.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Log includes
+#include "log_record.h"
+#include "logging_attributes.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @enum PushResult_TP
+ *
+ * @brief Outcome of handing a record to the backend.
+ *
+ */
+enum class PushResult_TP {
+    QUEUED = 0,   //!< The record will be written by the backend(0)
+    DROPPED = 1,  //!< The overflow policy dropped the record(1)
+    STOPPED = 2   //!< The backend is stopped, the caller has to write(2)
+};
+
+/** SN::Log::LogBackend_C
+ *
+ * @b Description
+ * A bounded queue of log records drained by a dedicated thread. Producers
+ * only move their record into a slot, the formatting and all stream and file
+ * I/O happen on the backend thread.
+ *
+ * Records are queued in one lane per severity band, ERROR and FATAL, WARN
+ * and INFO, DEBUG and TRACE. The backend always takes from the highest lane
+ * with records first and writes at most kMaxBatchRecords at a time, so an
+ * error waits for one batch of a TRACE flood at most instead of for the
+ * whole queue. Within a lane records keep the order they were pushed in,
+ * records of different lanes may be written out of order.
+ *
+ * The backend thread can be named, pinned to CPUs and given a real time
+ * policy, see BackendThreadSettings_TP. While the queue is empty it sleeps
+ * or polls depending on the wait strategy.
+ *
+ * When the output can't keep up the overflow policy decides between waiting
+ * and dropping. Drop counts are kept per level and reported in a WARN record
+ * as soon as the backlog has been cleared.
+ *
+ * @b Rationale
+ * A blocked output, e.g. a slow network disk or a full stdout pipe, would
+ * otherwise stall every logging thread inside the flush of the stream.
+ *
+ * @b Resource @b Ownership
+ * Owns the queued records and the backend thread.
+ */
+class LogBackend_C {
+   public:
+    /** Writes a batch of records on the backend thread */
+    using WriteBatch_TP = std::function<void(std::vector<LogRecord_TP>&)>;
+    /** Flushes the outputs and, when asked to, makes them durable. Returns
+     * false on failure */
+    using SyncOutputs_TP = std::function<bool(bool durable)>;
+
+    /** Number of priority lanes */
+    static constexpr size_t kLaneCount = 3;
+    /** Records the backend writes at most per batch */
+    static constexpr size_t kMaxBatchRecords = 256;
+
+    /**
+     * Gets the lane of a level, 0 is the highest.
+     *
+     * @param level log severity level
+     * @retval lane index
+     */
+    static size_t LaneOf(LogSeverityLevel_TP level) {
+        return level >= LogSeverityLevel_TP::LOG_ERROR  ? 0
+               : level >= LogSeverityLevel_TP::LOG_INFO ? 1
+                                                        : 2;
+    }
+
+    /**
+     * Starts the backend thread.
+     *
+     * @param capacity queue slots usable by every record
+     * @param write_batch writes records out, called on the backend thread
+     * @param sync_outputs syncs the outputs for RequestSync(), called on the
+     * backend thread
+     * @param thread_settings placement and wait strategy of the backend
+     * thread
+     */
+    LogBackend_C(size_t capacity, WriteBatch_TP write_batch,
+                 SyncOutputs_TP sync_outputs = SyncOutputs_TP(),
+                 const BackendThreadSettings_TP& thread_settings =
+                     BackendThreadSettings_TP());
+
+    /**
+     * Stops the backend, see Stop().
+     */
+    ~LogBackend_C();
+
+    LogBackend_C(const LogBackend_C& rhs) = delete;
+    LogBackend_C& operator=(const LogBackend_C& rhs) = delete;
+
+    /**
+     * Hands a record to the backend.
+     *
+     * @param record record to queue, moved from unless STOPPED is returned
+     * @param overflow overflow policy to apply when the queue is full
+     * @retval outcome
+     */
+    PushResult_TP Push(LogRecord_TP& record,
+                       const OverflowSettings_TP& overflow);
+
+    /**
+     * Waits until every record queued before the call has been written.
+     */
+    void Flush();
+
+    /**
+     * Requests a barrier behind every record queued before the call. Once
+     * the backend has written them it syncs the outputs and sets the result.
+     * Producers keep queueing meanwhile, requests arriving together share
+     * one sync.
+     *
+     * @param durable true to make the outputs durable, false to flush only
+     * @retval result of the sync, false on failure or when the backend has
+     * been stopped without syncing
+     */
+    std::future<bool> RequestSync(bool durable);
+
+    /**
+     * Writes the remaining records and joins the backend thread. Records
+     * pushed afterwards are rejected with STOPPED.
+     */
+    void Stop();
+
+    /**
+     * Makes an idle backend call the write callback with an empty batch
+     * whenever no record arrived for the interval, e.g. to notice that the
+     * load is gone. Takes effect with the next wait.
+     *
+     * @param interval idle interval, zero to sleep until the next record
+     */
+    void SetIdleInterval(std::chrono::milliseconds interval) {
+        m_idle_interval_ms.store(interval.count(), std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the number of queue slots usable by every record.
+     *
+     * @retval capacity
+     */
+    size_t GetCapacity() const { return m_capacity; }
+
+    /**
+     * Gets the settings the backend thread was started with.
+     *
+     * @retval thread settings
+     */
+    const BackendThreadSettings_TP& GetThreadSettings() const {
+        return m_thread_settings;
+    }
+
+    /**
+     * Gets the number of records that were queued when the batch being
+     * written was taken, for the write callback.
+     *
+     * @retval queued records including the batch
+     */
+    size_t GetBatchDepth() const { return m_batch_depth; }
+
+    /**
+     * Gets the number of records dropped at a level since start.
+     *
+     * @param level log severity level
+     * @retval dropped records
+     */
+    uint64_t GetDroppedCount(LogSeverityLevel_TP level) const;
+
+   private:
+    /**
+     * @struct SyncRequest_TP
+     *
+     * @brief A barrier waiting for the records before it.
+     *
+     */
+    struct SyncRequest_TP {
+        /** m_pushed of every lane at the time of the request */
+        uint64_t m_target[kLaneCount];
+        bool m_durable;
+        std::promise<bool> m_result;
+    };
+
+    /**
+     * @struct Lane_TP
+     *
+     * @brief Ring of the records of one severity band.
+     *
+     */
+    struct Lane_TP {
+        /** Records, each lane can hold the whole queue */
+        std::vector<LogRecord_TP> m_ring;
+        size_t m_head = 0;
+        size_t m_count = 0;
+        uint64_t m_pushed = 0;     //!< records accepted so far
+        uint64_t m_processed = 0;  //!< records written or dropped
+    };
+
+    /** Checks if every lane has processed the records of a target */
+    bool Reached(const uint64_t (&target)[kLaneCount]) const;
+    /** Drops the oldest record of the lowest lane with records, if that
+     * lane is not above a given one. Returns false when nothing was dropped */
+    bool DropOldest(size_t lane_index);
+    /** Applies name, affinity and policy, called on the backend thread */
+    void SetupThread();
+    /**
+     * Waits for records by the wait strategy, returns with the lock held.
+     *
+     * @param lock lock of m_mutex, held on entry
+     * @param timeout longest wait, zero to wait until woken
+     */
+    void Sleep(std::unique_lock<std::mutex>& lock,
+               std::chrono::nanoseconds timeout);
+    /**
+     * Takes the sleeping backend, if any, off the wait, called with the
+     * lock held.
+     *
+     * @retval true if Wake() has to be called after unlocking
+     */
+    bool TakeSleeper();
+    /** Wakes the backend taken by TakeSleeper() */
+    void Wake();
+    void Run();
+    void CountDrop(LogSeverityLevel_TP level);
+    bool ReportDrops(std::vector<LogRecord_TP>& batch);
+    void CompleteSyncs(std::unique_lock<std::mutex>& lock);
+
+    static constexpr size_t kLevelCount = 6;
+
+    size_t m_capacity;
+    /** Slots of a lane, larger than m_capacity by the reserve kept for
+     * records above the drop level */
+    size_t m_ring_size;
+    Lane_TP m_lanes[kLaneCount];
+    size_t m_count;         //!< queued records of all lanes
+    uint64_t m_pushed;      //!< records accepted by all lanes so far
+    size_t m_batch_depth;   //!< backend thread only
+    bool m_stop;
+    bool m_consumer_waiting;
+    /** Changed with every record, barrier and stop under m_mutex, polled
+     * lock free by a spinning and used as futex word by a parked backend */
+    std::atomic<uint32_t> m_wake_word;
+    std::atomic<int64_t> m_idle_interval_ms;  //!< see SetIdleInterval()
+
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    std::condition_variable m_processed_changed;
+
+    std::atomic<uint64_t> m_dropped[kLevelCount];
+    uint64_t m_reported[kLevelCount];  //!< backend thread only
+
+    /** Pending barriers, in the order of their targets */
+    std::vector<SyncRequest_TP> m_sync_requests;
+    std::vector<SyncRequest_TP> m_ready_syncs;  //!< backend thread only
+
+    WriteBatch_TP m_write_batch;
+    SyncOutputs_TP m_sync_outputs;
+    BackendThreadSettings_TP m_thread_settings;
+    std::thread m_thread;
+};  // end LogBackend_C
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,54 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_buffer.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+void LogBuffer_C::Reset() {
+    if (m_slab != nullptr) {
+        LogRecordPool_C::GetInstance()->Release(m_slab);
+        m_slab = nullptr;
+    }
+    m_size = 0;
+}
+
+void LogBuffer_C::Grow(size_t size) {
+    // Double to keep repeated appends amortized once past the slab size
+    size_t capacity = m_slab ? static_cast<size_t>(m_slab->m_capacity) * 2 : 0;
+    if (capacity < size) {
+        capacity = size;
+    }
+    LogSlab_TP* slab = LogRecordPool_C::GetInstance()->Acquire(capacity);
+    if (m_slab != nullptr) {
+        std::memcpy(slab->Data(), m_slab->Data(), m_size);
+        LogRecordPool_C::GetInstance()->Release(m_slab);
+    }
+    m_slab = slab;
+}
+
+}  // end namespace Log
+}  // end namespace SN
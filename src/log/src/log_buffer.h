@@ -0,0 +1,184 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_buffer.h
+ *
+ * @brief LogBuffer_C is a growable character buffer backed by the record
+ * pool, LogStreamBuf_C lets an std::ostream write into it.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <cstring>
+#include <streambuf>
+#include <string_view>
+
+// Log includes
+#include "log_record_pool.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/** SN::Log::LogBuffer_C
+ *
+ * @b Description
+ * A character buffer holding one pooled block. It starts without memory,
+ * takes a slab on the first write and moves to a larger size class when it
+ * runs full. Clear() keeps the block for reuse.
+ *
+ * @b Resource @b Ownership
+ * Owns its block and returns it to the pool on destruction, which may happen
+ * on another thread than the one which filled the buffer.
+ */
+class LogBuffer_C {
+   public:
+    LogBuffer_C() : m_slab(nullptr), m_size(0) {}
+    ~LogBuffer_C() { Reset(); }
+
+    LogBuffer_C(LogBuffer_C&& rhs) noexcept
+        : m_slab(rhs.m_slab), m_size(rhs.m_size) {
+        rhs.m_slab = nullptr;
+        rhs.m_size = 0;
+    }
+
+    LogBuffer_C& operator=(LogBuffer_C&& rhs) noexcept {
+        if (this != &rhs) {
+            Reset();
+            m_slab = rhs.m_slab;
+            m_size = rhs.m_size;
+            rhs.m_slab = nullptr;
+            rhs.m_size = 0;
+        }
+        return *this;
+    }
+
+    LogBuffer_C(const LogBuffer_C& rhs) = delete;
+    LogBuffer_C& operator=(const LogBuffer_C& rhs) = delete;
+
+    /**
+     * Appends characters.
+     *
+     * @param data characters to append
+     * @param size number of characters
+     */
+    void Append(const char* data, size_t size) {
+        std::memcpy(Reserve(size), data, size);
+        m_size += size;
+    }
+
+    /**
+     * Appends a string.
+     *
+     * @param str string to append
+     */
+    void Append(std::string_view str) { Append(str.data(), str.size()); }
+
+    /**
+     * Appends one character.
+     *
+     * @param ch character to append
+     */
+    void Append(char ch) {
+        *Reserve(1) = ch;
+        ++m_size;
+    }
+
+    /**
+     * Makes room for size more characters without committing them.
+     *
+     * @param size number of characters to make room for
+     * @retval write position, valid until the next call on this buffer
+     */
+    char* Reserve(size_t size) {
+        if (m_slab == nullptr || m_size + size > m_slab->m_capacity) {
+            Grow(m_size + size);
+        }
+        return m_slab->Data() + m_size;
+    }
+
+    /**
+     * Commits characters written through Reserve().
+     *
+     * @param size number of characters written
+     */
+    void Commit(size_t size) { m_size += size; }
+
+    /**
+     * Drops the content but keeps the block.
+     */
+    void Clear() { m_size = 0; }
+
+    /**
+     * Drops the content and returns the block to the pool.
+     */
+    void Reset();
+
+    const char* Data() const { return m_slab ? m_slab->Data() : ""; }
+    size_t Size() const { return m_size; }
+    bool Empty() const { return m_size == 0; }
+    std::string_view View() const { return std::string_view(Data(), m_size); }
+
+   private:
+    void Grow(size_t size);
+
+    LogSlab_TP* m_slab;
+    size_t m_size;
+};  // end LogBuffer_C
+
+/** SN::Log::LogStreamBuf_C
+ *
+ * @b Description
+ * Stream buffer which appends everything written to its stream to a
+ * LogBuffer_C, replacing the std::stringbuf of an std::ostringstream.
+ */
+class LogStreamBuf_C : public std::streambuf {
+   public:
+    explicit LogStreamBuf_C(LogBuffer_C& buffer) : m_buffer(buffer) {}
+
+   protected:
+    int_type overflow(int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            m_buffer.Append(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+        m_buffer.Append(data, static_cast<size_t>(size));
+        return size;
+    }
+
+   private:
+    LogBuffer_C& m_buffer;
+};  // end LogStreamBuf_C
+
+}  // end namespace Log
+}  // end namespace SN
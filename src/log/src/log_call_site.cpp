@@ -0,0 +1,85 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_call_site.h"
+
+#include <algorithm>
+
+#include "log_site_profiler.h"
+#include "logger.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+std::atomic<uint64_t> LogCallSite_C::m_generation{1};
+
+uint64_t LogCallSite_C::Refresh(const char* file, const char* function,
+                                uint32_t line) {
+    // Generation first, a config published meanwhile bumps it again and the
+    // next hit recomputes
+    uint64_t generation = m_generation.load(std::memory_order_acquire);
+    Logger_C* logger = Logger_C::GetInstance();
+    uint64_t configured = static_cast<uint64_t>(
+        logger->GetMinimumLevel(file, function, line));
+    uint64_t effective = std::max(
+        configured,
+        static_cast<uint64_t>(logger->GetLoadShedder().GetLevel()));
+    uint64_t state = generation << kGenerationShift | configured << 8 |
+                     effective;
+    LogSiteProfiler_C* profiler = LogSiteProfiler_C::GetInstance();
+    if (profiler->IsEnabled()) {
+        if (m_profile.load(std::memory_order_acquire) == nullptr) {
+            // The profiler returns the same counters to racing threads
+            m_profile.store(profiler->Register(this, file, function, line),
+                            std::memory_order_release);
+        }
+        state |= kProfiled;
+    }
+    m_state.store(state, std::memory_order_relaxed);
+    return state;
+}
+
+bool LogCallSite_C::Profile(LogSeverityLevel_TP level, uint64_t state) {
+    LogSiteProfile_TP* profile = m_profile.load(std::memory_order_acquire);
+    if (profile == nullptr) {
+        // State stored by another thread, not yet ordered with the counters
+        return Decide(level, state);
+    }
+    profile->m_hits.fetch_add(1, std::memory_order_relaxed);
+    if (!Decide(level, state)) {
+        profile->m_filtered.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Picked up by the LogMessageShink_C the macro constructs next
+    LogSiteProfiler_C::SetCurrentSite(profile);
+    return true;
+}
+
+void LogCallSite_C::CountShed(LogSeverityLevel_TP level) {
+    Logger_C::GetInstance()->CountShed(level);
+}
+
+}  // end namespace Log
+}  // end namespace SN
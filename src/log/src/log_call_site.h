@@ -0,0 +1,135 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_call_site.h
+ *
+ * @brief Per call-site cache of the level decision of the site rules.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <cstdint>
+
+// Log includes
+#include "logging_attributes.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+struct LogSiteProfile_TP;
+
+/** SN::Log::LogCallSite_C
+ *
+ * @b Description
+ * Remembers the minimum level of one SN_LOG site together with the config
+ * generation it was computed for. Every published config and every change
+ * of the load shedding level bump the global generation, so a site matches
+ * its file, function and line against the site rules once per change and
+ * not once per message.
+ *
+ * While LogSiteProfiler_C is enabled the cached state carries a flag which
+ * sends every hit through the out of line Profile(), disabled profiling
+ * costs nothing beyond the usual check.
+ *
+ * @note
+ * Constant initialized, so a function local static costs no guard.
+ */
+class LogCallSite_C {
+   public:
+    constexpr LogCallSite_C() : m_state(0), m_profile(nullptr) {}
+
+    LogCallSite_C(const LogCallSite_C& rhs) = delete;
+    LogCallSite_C& operator=(const LogCallSite_C& rhs) = delete;
+
+    /**
+     * Checks if the site logs at a given level, refreshes the cached
+     * decision when the config has changed since.
+     *
+     * @param level severity level of the message
+     * @param file file name at point of log
+     * @param function function name at point of log
+     * @param line line number at point of log
+     * @retval true if the message has to be logged otherwise false
+     */
+    bool Enabled(LogSeverityLevel_TP level, const char* file,
+                 const char* function, uint32_t line) {
+        uint64_t state = m_state.load(std::memory_order_relaxed);
+        if ((state >> kGenerationShift) !=
+            m_generation.load(std::memory_order_relaxed)) {
+            state = Refresh(file, function, line);
+        }
+        if ((state & kProfiled) != 0) {
+            return Profile(level, state);
+        }
+        return Decide(level, state);
+    }
+
+    /**
+     * Makes every site recompute its decision, called whenever a config is
+     * published.
+     */
+    static void Invalidate() {
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+   private:
+    static constexpr uint64_t kProfiled = uint64_t(1) << 16;
+    static constexpr int kGenerationShift = 17;
+
+    static bool Decide(LogSeverityLevel_TP level, uint64_t state) {
+        if (static_cast<uint64_t>(level) >= (state & 0xff)) {
+            return true;
+        }
+        if (static_cast<uint64_t>(level) >= (state >> 8 & 0xff)) {
+            // Enabled by the config, suppressed by load shedding
+            CountShed(level);
+        }
+        return false;
+    }
+
+    uint64_t Refresh(const char* file, const char* function, uint32_t line);
+    bool Profile(LogSeverityLevel_TP level, uint64_t state);
+    static void CountShed(LogSeverityLevel_TP level);
+
+    /** Generation the decision was taken for from bit 17 on, kProfiled while
+     * profiling, the configured minimum level in the second byte and the
+     * effective one, raised by load shedding, in the lowest byte. Zero until
+     * the first use */
+    std::atomic<uint64_t> m_state;
+    /** Counters of the site, registered on the first profiled hit */
+    std::atomic<LogSiteProfile_TP*> m_profile;
+    /** Config generation, starts at one so that no site is up to date */
+    static std::atomic<uint64_t> m_generation;
+};  // end LogCallSite_C
+
+}  // end namespace Log
+}  // end namespace SN
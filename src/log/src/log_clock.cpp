@@ -0,0 +1,138 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_clock.h"
+
+#include <chrono>
+#include <thread>
+
+#ifdef SN_LOG_HAS_TSC
+#include <cpuid.h>
+#endif
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+int64_t SystemNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
+LogClock_C* LogClock_C::GetInstance() {
+    // Never destroyed, records may still be formatted from static destructors
+    static LogClock_C* instance = new LogClock_C();
+    return instance;
+}
+
+LogClock_C::LogClock_C() : m_calibration(nullptr), m_external_ns(0) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // A short first calibration, Init() refines it
+    Publish(HasInvariantTsc() ? ClockSource_TP::TSC
+                              : ClockSource_TP::MONOTONIC_RAW,
+            2);
+}
+
+bool LogClock_C::HasInvariantTsc() {
+#ifdef SN_LOG_HAS_TSC
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+        eax < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+int64_t LogClock_C::ReadFallbackTicks(ClockSource_TP source) {
+    if (source == ClockSource_TP::SYSTEM) {
+        return SystemNs();
+    }
+    // MONOTONIC_RAW where the raw clock is not available
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void LogClock_C::Calibrate(int period_ms /*= 20*/) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Publish(GetSource(), period_ms);
+}
+
+void LogClock_C::SetSource(ClockSource_TP source) {
+    if (source == ClockSource_TP::TSC && !HasInvariantTsc()) {
+        source = ClockSource_TP::MONOTONIC_RAW;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Publish(source, 20);
+}
+
+void LogClock_C::Publish(ClockSource_TP source, int period_ms) {
+    std::unique_ptr<LogClockCalibration_TP> calibration(
+        new LogClockCalibration_TP{source, 0, 0, 1.0});
+    switch (source) {
+        case ClockSource_TP::SYSTEM:
+        case ClockSource_TP::EXTERNAL:
+            // Already nanoseconds since the epoch
+            break;
+        case ClockSource_TP::MONOTONIC_RAW:
+            calibration->m_base_ticks = ReadTicks(source);
+            calibration->m_base_ns = SystemNs();
+            break;
+        case ClockSource_TP::TSC: {
+            // Count ticks against the steady clock over the period
+            auto start = std::chrono::steady_clock::now();
+            int64_t start_ticks = ReadTicks(source);
+            std::this_thread::sleep_for(std::chrono::milliseconds(period_ms));
+            int64_t end_ticks = ReadTicks(source);
+            auto end = std::chrono::steady_clock::now();
+            int64_t elapsed_ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end -
+                                                                     start)
+                    .count();
+            if (end_ticks > start_ticks) {
+                calibration->m_ns_per_tick =
+                    static_cast<double>(elapsed_ns) /
+                    static_cast<double>(end_ticks - start_ticks);
+            }
+            calibration->m_base_ticks = ReadTicks(source);
+            calibration->m_base_ns = SystemNs();
+            break;
+        }
+    }
+    // Release pairs with the acquire in Now()
+    m_calibration.store(calibration.get(), std::memory_order_release);
+    m_history.emplace_back(std::move(calibration));
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,258 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_clock.h
+ *
+ * @brief LogClock_C takes the time stamps of log records from a raw counter
+ * and converts them to wall time at the output.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SN_LOG_HAS_TSC 1
+#endif
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @enum ClockSource_TP
+ *
+ * @brief Counter the time stamps of log records are taken from.
+ *
+ */
+enum class ClockSource_TP {
+    SYSTEM = 0,         //!< std::chrono::system_clock(0)
+    MONOTONIC_RAW = 1,  //!< CLOCK_MONOTONIC_RAW, steady_clock elsewhere(1)
+    TSC = 2,            //!< CPU time stamp counter, x86 only(2)
+    EXTERNAL = 3        //!< Time set by the application, e.g. a simulator(3)
+};
+
+/**
+ * @struct LogClockCalibration_TP
+ *
+ * @brief Maps the ticks of a clock source to nanoseconds since the epoch.
+ *
+ * A calibration is immutable once published. Every time point keeps a
+ * pointer to the calibration it was taken with, so a recalibration or a
+ * change of the source never affects records which are still queued.
+ *
+ */
+struct LogClockCalibration_TP {
+    ClockSource_TP m_source;  //!< counter to read
+    int64_t m_base_ticks;     //!< counter value at m_base_ns
+    int64_t m_base_ns;        //!< wall time at m_base_ticks
+    double m_ns_per_tick;     //!< length of one tick
+};
+
+/**
+ * @struct LogTimePoint_TP
+ *
+ * @brief Raw time stamp of a log record.
+ *
+ */
+struct LogTimePoint_TP {
+    /**
+     * Converts the raw counter value to wall time.
+     *
+     * @retval nanoseconds since the epoch, 0 for an empty time point
+     */
+    int64_t ToEpochNs() const {
+        if (m_calibration == nullptr) {
+            return 0;
+        }
+        if (m_calibration->m_ns_per_tick == 1.0) {
+            // Exact for nanosecond counters, a double holds 53 bits only
+            return m_calibration->m_base_ns +
+                   (m_ticks - m_calibration->m_base_ticks);
+        }
+        return m_calibration->m_base_ns +
+               static_cast<int64_t>(
+                   static_cast<double>(m_ticks - m_calibration->m_base_ticks) *
+                   m_calibration->m_ns_per_tick);
+    }
+
+    /**
+     * Makes a time point from a wall time, e.g. the time stamp of a recorded
+     * record to replay with Logger_C::WriteBatch().
+     *
+     * @param epoch_ns nanoseconds since the epoch
+     * @retval time point
+     */
+    static LogTimePoint_TP FromEpochNs(int64_t epoch_ns) {
+        static constexpr LogClockCalibration_TP kEpoch{ClockSource_TP::EXTERNAL,
+                                                       0, 0, 1.0};
+        LogTimePoint_TP time_point;
+        time_point.m_ticks = epoch_ns;
+        time_point.m_calibration = &kEpoch;
+        return time_point;
+    }
+
+    int64_t m_ticks = 0;  //!< raw counter value
+    /** Calibration at the time of capture, owned by LogClock_C */
+    const LogClockCalibration_TP* m_calibration = nullptr;
+};
+
+/** SN::Log::LogClock_C
+ *
+ * @b Description
+ * Process wide clock of the logger. Now() only reads a raw counter, the
+ * conversion to wall time is left to the thread which formats the record.
+ *
+ * The TSC is used by default where it is invariant, i.e. ticks at a constant
+ * rate across frequency changes, otherwise CLOCK_MONOTONIC_RAW. Both are
+ * calibrated against the system clock, once when the clock is created and
+ * again by Calibrate(), which Logger_C::Init() calls.
+ *
+ * The EXTERNAL source reads a value the application sets with
+ * SetExternalTime(), e.g. the simulation time of a simulator. The source is a
+ * plain enum checked by a switch, so there is no virtual call per record.
+ *
+ * @b Resource @b Ownership
+ * Owns every calibration published so far.
+ */
+class LogClock_C {
+   public:
+    /**
+     * Gets the process wide clock, never destroyed.
+     *
+     * @retval clock object
+     */
+    static LogClock_C* GetInstance();
+
+    LogClock_C(const LogClock_C& rhs) = delete;
+    LogClock_C& operator=(const LogClock_C& rhs) = delete;
+
+    /**
+     * Takes a raw time stamp.
+     *
+     * @retval time point to convert later with ToEpochNs()
+     */
+    LogTimePoint_TP Now() const {
+        LogTimePoint_TP time_point;
+        time_point.m_calibration =
+            m_calibration.load(std::memory_order_acquire);
+        time_point.m_ticks = ReadTicks(time_point.m_calibration->m_source);
+        return time_point;
+    }
+
+    /**
+     * Measures the tick rate of the current source again and pairs it with
+     * the system clock. Blocks for about the measuring period.
+     *
+     * @param period_ms measuring period in milliseconds
+     */
+    void Calibrate(int period_ms = 20);
+
+    /**
+     * Switches the counter time stamps are taken from. TSC falls back to
+     * MONOTONIC_RAW where there is no invariant TSC.
+     *
+     * @param source clock source
+     */
+    void SetSource(ClockSource_TP source);
+
+    /**
+     * Gets the counter time stamps are taken from.
+     *
+     * @retval clock source
+     */
+    ClockSource_TP GetSource() const {
+        return m_calibration.load(std::memory_order_acquire)->m_source;
+    }
+
+    /**
+     * Sets the time read by the EXTERNAL source.
+     *
+     * @param epoch_ns nanoseconds since the epoch of the application's clock
+     */
+    void SetExternalTime(int64_t epoch_ns) {
+        m_external_ns.store(epoch_ns, std::memory_order_relaxed);
+    }
+
+    /**
+     * Checks if the CPU has an invariant TSC.
+     *
+     * @retval true if the TSC can be used otherwise false
+     */
+    static bool HasInvariantTsc();
+
+   private:
+    LogClock_C();
+
+    int64_t ReadTicks(ClockSource_TP source) const {
+        switch (source) {
+            case ClockSource_TP::EXTERNAL:
+                return m_external_ns.load(std::memory_order_relaxed);
+#ifdef SN_LOG_HAS_TSC
+            case ClockSource_TP::TSC:
+                return static_cast<int64_t>(__rdtsc());
+#endif
+#if defined(__linux__)
+            case ClockSource_TP::MONOTONIC_RAW: {
+                timespec now;
+                clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+                return now.tv_sec * int64_t{1000000000} + now.tv_nsec;
+            }
+#endif
+            default:
+                return ReadFallbackTicks(source);
+        }
+    }
+
+    static int64_t ReadFallbackTicks(ClockSource_TP source);
+
+    /**
+     * Builds and publishes a calibration, m_mutex must be held.
+     */
+    void Publish(ClockSource_TP source, int period_ms);
+
+    std::atomic<const LogClockCalibration_TP*> m_calibration;
+    std::atomic<int64_t> m_external_ns;
+    /** Every calibration published, kept for the time points using them */
+    std::vector<std::unique_ptr<const LogClockCalibration_TP>> m_history;
+    std::mutex m_mutex;  //!< serializes calibrating
+};  // end LogClock_C
+
+}  // end namespace Log
+}  // end namespace SN
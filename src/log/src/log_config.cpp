@@ -0,0 +1,466 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_config.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#endif
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+std::string Trim(const std::string& str) {
+    size_t begin = str.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+}
+
+std::string ToUpper(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::toupper(ch));
+    });
+    return str;
+}
+
+bool ParseLogType(const std::string& name, LogType_TP& type) {
+    std::string upper = ToUpper(name);
+    if (upper == "NO_LOG" || upper == "NONE") {
+        type = LogType_TP::NO_LOG;
+    } else if (upper == "CONSOLE_LOG" || upper == "CONSOLE") {
+        type = LogType_TP::CONSOLE_LOG;
+    } else if (upper == "FILE_LOG" || upper == "FILE") {
+        type = LogType_TP::FILE_LOG;
+    } else if (upper == "BOTH") {
+        type = LogType_TP::BOTH;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ParseOverflowPolicy(const std::string& name, OverflowPolicy_TP& policy) {
+    std::string upper = ToUpper(name);
+    if (upper == "BLOCK") {
+        policy = OverflowPolicy_TP::BLOCK;
+    } else if (upper == "DROP_NEWEST") {
+        policy = OverflowPolicy_TP::DROP_NEWEST;
+    } else if (upper == "DROP_OLDEST") {
+        policy = OverflowPolicy_TP::DROP_OLDEST;
+    } else if (upper == "DROP_BELOW_LEVEL") {
+        policy = OverflowPolicy_TP::DROP_BELOW_LEVEL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+LogConfig_TP::LogConfig_TP()
+    : m_time_stamp_mode(TimeStampMode_TP::DATE_TIME),
+      m_log_file_name("supernova_log.txt"),
+      m_flush_level(LogSeverityLevel_TP::LOG_TRACE),
+      m_format("[%T] [%F:%C %P] [%L] :: %S"),
+      m_overflow{OverflowPolicy_TP::BLOCK, LogSeverityLevel_TP::LOG_ERROR,
+                 std::chrono::milliseconds(1000)},
+      m_blob_limit(256) {
+#ifdef _DEBUG
+    m_log_severity_level = LogSeverityLevel_TP::LOG_TRACE;
+    m_log_type = LogType_TP::BOTH;
+#else
+    m_log_severity_level = LogSeverityLevel_TP::LOG_INFO;
+    m_log_type = LogType_TP::FILE_LOG;
+#endif
+    m_gate_level = m_log_severity_level;
+}
+
+bool GlobMatch(std::string_view pattern, std::string_view text) {
+    // Iterative matcher, backtracks only to the last '*'
+    size_t p = 0;
+    size_t t = 0;
+    size_t star = std::string_view::npos;
+    size_t star_text = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() &&
+            (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            star_text = t;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            t = ++star_text;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+bool LogSiteRule_TP::Matches(std::string_view file,
+                             std::string_view function,
+                             uint32_t line) const {
+    if (line < m_first_line || line > m_last_line) {
+        return false;
+    }
+    if (!m_function.empty() && !GlobMatch(m_function, function)) {
+        return false;
+    }
+    if (m_file_glob.empty() || GlobMatch(m_file_glob, file)) {
+        return true;
+    }
+    // __FILE__ may carry any prefix, so "net/socket.cpp" matches
+    // "/src/net/socket.cpp" as well
+    for (size_t pos = file.find('/'); pos != std::string_view::npos;
+         pos = file.find('/', pos + 1)) {
+        if (GlobMatch(m_file_glob, file.substr(pos + 1))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+LogSeverityLevel_TP LogConfig_TP::MinimumLevel(std::string_view file,
+                                               std::string_view function,
+                                               uint32_t line) const {
+    for (auto rule = m_site_rules.rbegin(); rule != m_site_rules.rend();
+         ++rule) {
+        if (rule->Matches(file, function, line)) {
+            return rule->m_level;
+        }
+    }
+    for (const auto& component : m_component_levels) {
+        size_t pos = file.find(component.first);
+        while (pos != std::string_view::npos) {
+            size_t end = pos + component.first.size();
+            bool starts = pos == 0 || file[pos - 1] == '/' ||
+                          file[pos - 1] == '\\';
+            bool ends = end < file.size() &&
+                        (file[end] == '/' || file[end] == '\\');
+            if (starts && ends) {
+                return component.second;
+            }
+            pos = file.find(component.first, pos + 1);
+        }
+    }
+    return m_log_severity_level;
+}
+
+void LogConfig_TP::UpdateGateLevel() {
+    m_gate_level = m_log_severity_level;
+    for (const auto& component : m_component_levels) {
+        m_gate_level = std::min(m_gate_level, component.second);
+    }
+    for (const auto& rule : m_site_rules) {
+        m_gate_level = std::min(m_gate_level, rule.m_level);
+    }
+}
+
+bool ParseLogSiteRule(const std::string& spec, LogSeverityLevel_TP level,
+                      LogSiteRule_TP& rule) {
+    LogSiteRule_TP parsed;
+    parsed.m_level = level;
+    std::string file = Trim(spec);
+    size_t at = file.find('@');
+    if (at != std::string::npos) {
+        parsed.m_function = Trim(file.substr(at + 1));
+        file.erase(at);
+        if (parsed.m_function.empty()) {
+            return false;
+        }
+    }
+    size_t colon = file.find(':');
+    if (colon != std::string::npos) {
+        std::string range = file.substr(colon + 1);
+        file.erase(colon);
+        if (range.empty() ||
+            !std::isdigit(static_cast<unsigned char>(range[0]))) {
+            return false;
+        }
+        char* end = nullptr;
+        unsigned long first = std::strtoul(range.c_str(), &end, 10);
+        unsigned long last = first;
+        if (*end == '-') {
+            const char* begin = end + 1;
+            last = std::strtoul(begin, &end, 10);
+            if (end == begin) {
+                return false;
+            }
+        }
+        if (*end != '\0' || first > last || last > UINT32_MAX) {
+            return false;
+        }
+        parsed.m_first_line = static_cast<uint32_t>(first);
+        parsed.m_last_line = static_cast<uint32_t>(last);
+    }
+    parsed.m_file_glob = Trim(file);
+    if (parsed.m_file_glob == "*") {
+        parsed.m_file_glob.clear();
+    }
+    rule = std::move(parsed);
+    return true;
+}
+
+bool ParseTimeStampMode(const std::string& name, TimeStampMode_TP& mode) {
+    std::string upper = ToUpper(name);
+    if (upper == "NONE") {
+        mode = TimeStampMode_TP::NONE;
+    } else if (upper == "EPOCH_SECONDS") {
+        mode = TimeStampMode_TP::EPOCH_SECONDS;
+    } else if (upper == "EPOCH_MILLI_SECONDS") {
+        mode = TimeStampMode_TP::EPOCH_MILLI_SECONDS;
+    } else if (upper == "EPOCH_MICRO_SECONDS") {
+        mode = TimeStampMode_TP::EPOCH_MICRO_SECONDS;
+    } else if (upper == "DATE_TIME") {
+        mode = TimeStampMode_TP::DATE_TIME;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ParseLogSeverityLevel(const std::string& name,
+                           LogSeverityLevel_TP& level) {
+    std::string upper = ToUpper(Trim(name));
+    if (upper.compare(0, 4, "LOG_") == 0) {
+        upper.erase(0, 4);
+    }
+    if (upper == "TRACE") {
+        level = LogSeverityLevel_TP::LOG_TRACE;
+    } else if (upper == "DEBUG") {
+        level = LogSeverityLevel_TP::LOG_DEBUG;
+    } else if (upper == "INFO") {
+        level = LogSeverityLevel_TP::LOG_INFO;
+    } else if (upper == "WARN") {
+        level = LogSeverityLevel_TP::LOG_WARN;
+    } else if (upper == "ERROR") {
+        level = LogSeverityLevel_TP::LOG_ERROR;
+    } else if (upper == "FATAL") {
+        level = LogSeverityLevel_TP::LOG_FATAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ParseLogConfig(const std::string& text, LogConfig_TP& config,
+                    std::string& error) {
+    LogConfig_TP parsed = config;
+    // Component levels and site rules are replaced as a whole by the file
+    parsed.m_component_levels.clear();
+    parsed.m_site_rules.clear();
+    std::istringstream lines(text);
+    std::string line;
+    int line_number = 0;
+    while (std::getline(lines, line)) {
+        ++line_number;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        line = Trim(line);
+        if (line.empty()) {
+            continue;
+        }
+        size_t equal = line.find('=');
+        if (equal == std::string::npos) {
+            error = "line " + std::to_string(line_number) + ": missing '='";
+            return false;
+        }
+        std::string key = Trim(line.substr(0, equal));
+        std::string value = Trim(line.substr(equal + 1));
+        bool ok = true;
+        if (key == "level") {
+            ok = ParseLogSeverityLevel(value, parsed.m_log_severity_level);
+        } else if (key.compare(0, 6, "level.") == 0 && key.size() > 6) {
+            LogSeverityLevel_TP level;
+            ok = ParseLogSeverityLevel(value, level);
+            parsed.m_component_levels.emplace_back(key.substr(6), level);
+        } else if (key.compare(0, 5, "site.") == 0 && key.size() > 5) {
+            // OFF keeps FATAL, which aborts and so can't be silenced
+            LogSeverityLevel_TP level = LogSeverityLevel_TP::LOG_FATAL;
+            LogSiteRule_TP rule;
+            ok = (ToUpper(value) == "OFF" ||
+                  ParseLogSeverityLevel(value, level)) &&
+                 ParseLogSiteRule(key.substr(5), level, rule);
+            parsed.m_site_rules.push_back(std::move(rule));
+        } else if (key == "format") {
+            parsed.m_format = LogFormat_C(value);
+        } else if (key == "timestamp") {
+            ok = ParseTimeStampMode(value, parsed.m_time_stamp_mode);
+        } else if (key == "type") {
+            ok = ParseLogType(value, parsed.m_log_type);
+        } else if (key == "file") {
+            ok = !value.empty();
+            parsed.m_log_file_name = value;
+        } else if (key == "flush_level") {
+            ok = ParseLogSeverityLevel(value, parsed.m_flush_level);
+        } else if (key == "overflow") {
+            ok = ParseOverflowPolicy(value, parsed.m_overflow.m_policy);
+        } else if (key == "overflow_level") {
+            ok = ParseLogSeverityLevel(value, parsed.m_overflow.m_level);
+        } else if (key == "block_timeout_ms") {
+            char* end = nullptr;
+            long timeout = std::strtol(value.c_str(), &end, 10);
+            ok = !value.empty() && *end == '\0' && timeout >= 0;
+            parsed.m_overflow.m_block_timeout =
+                std::chrono::milliseconds(timeout);
+        } else if (key == "load_shedding") {
+            std::string upper = ToUpper(value);
+            ok = upper == "ON" || upper == "OFF";
+            parsed.m_load_shedding.m_enabled = upper == "ON";
+        } else if (key == "shed_max_level") {
+            ok = ParseLogSeverityLevel(value,
+                                       parsed.m_load_shedding.m_max_level);
+        } else if (key == "blob_limit") {
+            char* end = nullptr;
+            unsigned long long limit = std::strtoull(value.c_str(), &end, 10);
+            ok = !value.empty() && *end == '\0' && value[0] != '-';
+            parsed.m_blob_limit = static_cast<size_t>(limit);
+        } else {
+            error = "line " + std::to_string(line_number) + ": unknown key '" +
+                    key + "'";
+            return false;
+        }
+        if (!ok) {
+            error = "line " + std::to_string(line_number) +
+                    ": invalid value '" + value + "' for '" + key + "'";
+            return false;
+        }
+    }
+    parsed.UpdateGateLevel();
+    config = parsed;
+    return true;
+}
+
+LogConfigWatcher_C::LogConfigWatcher_C(
+    const std::string& file_name,
+    std::function<void(const std::string&)> on_change)
+    : m_file_name(file_name),
+      m_on_change(std::move(on_change)),
+      m_inotify_fd(-1),
+      m_stop(false) {
+    size_t slash = m_file_name.find_last_of('/');
+    m_dir_name =
+        slash == std::string::npos ? "." : m_file_name.substr(0, slash + 1);
+    m_base_name =
+        slash == std::string::npos ? m_file_name : m_file_name.substr(slash + 1);
+#ifdef __linux__
+    // Set up the watch before returning so no write after construction is
+    // missed
+    m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify_fd < 0) {
+        std::cerr << "[ERROR] : Couldn't watch config file " << m_file_name
+                  << std::endl;
+        return;
+    }
+    // Only complete files, a file just created may still be empty
+    if (inotify_add_watch(m_inotify_fd, m_dir_name.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "[ERROR] : Couldn't watch directory " << m_dir_name
+                  << std::endl;
+        close(m_inotify_fd);
+        m_inotify_fd = -1;
+        return;
+    }
+#endif
+    m_thread = std::thread(&LogConfigWatcher_C::Run, this);
+}
+
+LogConfigWatcher_C::~LogConfigWatcher_C() {
+    m_stop = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+#ifdef __linux__
+    if (m_inotify_fd >= 0) {
+        close(m_inotify_fd);
+    }
+#endif
+}
+
+#ifdef __linux__
+void LogConfigWatcher_C::Run() {
+    alignas(inotify_event) char buffer[4096];
+    while (!m_stop) {
+        // Wake up regularly to notice the stop request
+        pollfd poll_fd = {m_inotify_fd, POLLIN, 0};
+        if (poll(&poll_fd, 1, 200) <= 0) {
+            continue;
+        }
+        bool changed = false;
+        ssize_t length;
+        while ((length = read(m_inotify_fd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                auto* event = reinterpret_cast<inotify_event*>(ptr);
+                if (event->len != 0 && m_base_name == event->name) {
+                    changed = true;
+                }
+                ptr += sizeof(inotify_event) + event->len;
+            }
+        }
+        if (changed) {
+            m_on_change(m_file_name);
+        }
+    }
+}
+#else
+void LogConfigWatcher_C::Run() {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    auto last_write = fs::last_write_time(m_file_name, error);
+    while (!m_stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        auto write_time = fs::last_write_time(m_file_name, error);
+        if (!error && write_time != last_write) {
+            last_write = write_time;
+            m_on_change(m_file_name);
+        }
+    }
+}
+#endif
+
+}  // end namespace Log
+}  // end namespace SN
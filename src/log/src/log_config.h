@@ -0,0 +1,256 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_config.h
+ *
+ * @brief Immutable logger configuration snapshot, its text file parser and
+ * a watcher that reloads the file when it changes.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Log includes
+#include "log_format.h"
+#include "logging_attributes.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct LogSiteRule_TP
+ *
+ * @brief Minimum level for the log sites of a file, function or line range.
+ *
+ */
+struct LogSiteRule_TP {
+    /**
+     * Checks if a log site falls under the rule.
+     *
+     * @param file file name at point of log
+     * @param function function name at point of log
+     * @param line line number at point of log
+     * @retval true if the rule applies otherwise false
+     */
+    bool Matches(std::string_view file, std::string_view function,
+                 uint32_t line) const;
+
+    /** Glob on the file path or on a trailing part of it starting after a
+     * '/', empty matches every file */
+    std::string m_file_glob;
+    std::string m_function;  //!< glob on the function name, empty for any
+    uint32_t m_first_line = 0;
+    uint32_t m_last_line = UINT32_MAX;
+    LogSeverityLevel_TP m_level = LogSeverityLevel_TP::LOG_TRACE;
+};
+
+/**
+ * Matches text against a glob, '*' matches any sequence including '/' and
+ * '?' any single character.
+ *
+ * @param pattern glob pattern
+ * @param text text to match
+ * @retval true if the whole text matches otherwise false
+ */
+bool GlobMatch(std::string_view pattern, std::string_view text);
+
+/**
+ * Parses a site rule given as FILE_GLOB[:FIRST[-LAST]][@FUNCTION], e.g.
+ * "physics/step*.cpp", "io.cpp:100-180" or "*@Integrate".
+ *
+ * @param spec rule specification
+ * @param level minimum level of the matching sites
+ * @param rule parsed rule
+ * @retval true on success otherwise false
+ */
+bool ParseLogSiteRule(const std::string& spec, LogSeverityLevel_TP level,
+                      LogSiteRule_TP& rule);
+
+/**
+ * @struct LogConfig_TP
+ *
+ * @brief Logger settings published as one immutable snapshot.
+ *
+ * Logger_C never modifies a published snapshot. A change copies the current
+ * snapshot, edits the copy and swaps the pointer, so a reader that loaded the
+ * pointer once sees a consistent set of settings for the whole message.
+ *
+ */
+struct LogConfig_TP {
+    LogConfig_TP();
+
+    /**
+     * Checks a message against the global, per component and per site
+     * levels.
+     *
+     * @param level severity level of the message
+     * @param file file name at point of log
+     * @param function function name at point of log
+     * @param line line number at point of log
+     * @retval true if the message has to be logged otherwise false
+     */
+    bool Accepts(LogSeverityLevel_TP level, std::string_view file,
+                 std::string_view function = std::string_view(),
+                 uint32_t line = 0) const {
+        return MinimumLevel(file, function, line) <= level;
+    }
+
+    /**
+     * Gets the lowest level a log site accepts. The last matching site rule
+     * decides, then the first matching component, then the global level.
+     *
+     * @param file file name at point of log
+     * @param function function name at point of log
+     * @param line line number at point of log
+     * @retval minimum level
+     */
+    LogSeverityLevel_TP MinimumLevel(std::string_view file,
+                                     std::string_view function,
+                                     uint32_t line) const;
+
+    /**
+     * Recomputes m_gate_level after the levels have been changed.
+     */
+    void UpdateGateLevel();
+
+    LogSeverityLevel_TP m_log_severity_level;  //!< global minimum level
+    /** Minimum levels of components, a component matches a directory name
+     * in the path of the file at point of log */
+    std::vector<std::pair<std::string, LogSeverityLevel_TP>> m_component_levels;
+    /** Levels of single files, functions or line ranges, see
+     * LogSiteRule_TP */
+    std::vector<LogSiteRule_TP> m_site_rules;
+    /** Lowest level any component or site accepts, used for the cheap early
+     * check */
+    LogSeverityLevel_TP m_gate_level;
+    TimeStampMode_TP m_time_stamp_mode;  //!< time stamp mode
+    LogType_TP m_log_type;               //!< console and/or file output
+    std::string m_log_file_name;         //!< log file name
+    /** Messages at this level or higher flush the output streams */
+    LogSeverityLevel_TP m_flush_level;
+    LogFormat_C m_format;  //!< compiled format string
+    /** What the asynchronous logger does when its queue is full */
+    OverflowSettings_TP m_overflow;
+    /** When the asynchronous logger raises its level under overload */
+    LoadSheddingSettings_TP m_load_shedding;
+    /** Bytes SN_LOG_HEX and SN_LOG_BASE64 encode at most per message */
+    size_t m_blob_limit;
+};
+
+/**
+ * Parses the name of a severity level, e.g. "INFO" or "LOG_INFO".
+ *
+ * @param name level name, case insensitive
+ * @param level parsed level
+ * @retval true on success otherwise false
+ */
+bool ParseLogSeverityLevel(const std::string& name, LogSeverityLevel_TP& level);
+
+/**
+ * Parses the name of a time stamp mode, e.g. "DATE_TIME" or
+ * "EPOCH_MILLI_SECONDS".
+ *
+ * @param name mode name, case insensitive
+ * @param mode parsed mode
+ * @retval true on success otherwise false
+ */
+bool ParseTimeStampMode(const std::string& name, TimeStampMode_TP& mode);
+
+/**
+ * Parses the text of a logger configuration file on top of a base snapshot.
+ *
+ * The file holds one "key = value" pair per line, '#' starts a comment.
+ * Supported keys are level, level.<component>, site.<rule>, format,
+ * timestamp, type, file, flush_level, overflow, overflow_level,
+ * block_timeout_ms, blob_limit, load_shedding (ON or OFF) and
+ * shed_max_level. The rule of a site key is parsed by
+ * ParseLogSiteRule(), its value is a level or OFF.
+ * Keys which are not present keep the value of the base.
+ *
+ * @param text content of the configuration file
+ * @param config in: the base snapshot, out: the parsed snapshot
+ * @param error description of the first error
+ * @retval true on success otherwise false
+ */
+bool ParseLogConfig(const std::string& text, LogConfig_TP& config,
+                    std::string& error);
+
+/** SN::Log::LogConfigWatcher_C
+ *
+ * @b Description
+ * Watches a configuration file from a background thread and calls back
+ * whenever it has been written or replaced. Editors usually replace files by
+ * renaming, so the containing directory is watched rather than the file.
+ *
+ * @note
+ * Uses inotify on Linux and polls the modification time elsewhere.
+ */
+class LogConfigWatcher_C {
+   public:
+    /**
+     * Starts watching.
+     *
+     * @param file_name configuration file to watch
+     * @param on_change callback run on the watcher thread
+     */
+    LogConfigWatcher_C(const std::string& file_name,
+                       std::function<void(const std::string&)> on_change);
+
+    /**
+     * Stops watching and joins the watcher thread.
+     */
+    ~LogConfigWatcher_C();
+
+    LogConfigWatcher_C(const LogConfigWatcher_C& rhs) = delete;
+    LogConfigWatcher_C& operator=(const LogConfigWatcher_C& rhs) = delete;
+
+   private:
+    void Run();
+
+    std::string m_file_name;
+    std::string m_dir_name;
+    std::string m_base_name;
+    std::function<void(const std::string&)> m_on_change;
+    int m_inotify_fd;  //!< inotify descriptor, -1 when polling
+    std::atomic<bool> m_stop;
+    std::thread m_thread;
+};  // end LogConfigWatcher_C
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,136 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_context.h"
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "log_format_kernels.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+/** Thread id, thread name and attributes of a thread, back to back */
+struct ThreadBlock_TP {
+    ThreadBlock_TP() {
+#if defined(__linux__)
+        uint64_t id = static_cast<uint64_t>(syscall(SYS_gettid));
+        char name[16] = {0};
+        if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) {
+            m_name_size = std::char_traits<char>::length(name);
+        }
+#else
+        uint64_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+        const char* name = "";
+#endif
+        char number[Kernels::kMaxIntegerChars];
+        m_id_size = Kernels::FormatUnsigned(id, number);
+        m_data.append(number, m_id_size);
+        m_data.append(name, m_name_size);
+    }
+
+    std::string_view Context() const {
+        return std::string_view(m_data).substr(m_id_size + m_name_size);
+    }
+
+    std::string m_data;
+    size_t m_id_size = 0;
+    size_t m_name_size = 0;
+    /** Start of each attribute within the context */
+    std::vector<size_t> m_starts;
+};
+
+ThreadBlock_TP& GetBlock() {
+    thread_local ThreadBlock_TP block;
+    return block;
+}
+
+}  // namespace
+
+void LogContext_C::Push(std::string_view key, std::string_view value) {
+    ThreadBlock_TP& block = GetBlock();
+    block.m_starts.push_back(block.m_data.size());
+    if (!block.Context().empty()) {
+        block.m_data += ' ';
+    }
+    block.m_data.append(key.data(), key.size());
+    block.m_data += '=';
+    block.m_data.append(value.data(), value.size());
+}
+
+void LogContext_C::Pop() {
+    ThreadBlock_TP& block = GetBlock();
+    if (!block.m_starts.empty()) {
+        block.m_data.resize(block.m_starts.back());
+        block.m_starts.pop_back();
+    }
+}
+
+std::string_view LogContext_C::GetContext() { return GetBlock().Context(); }
+
+void LogContext_C::SetThreadName(const std::string& name) {
+    ThreadBlock_TP& block = GetBlock();
+    block.m_data.replace(block.m_id_size, block.m_name_size, name);
+    // The attributes move along with the end of the name
+    for (size_t& start : block.m_starts) {
+        start = start - block.m_name_size + name.size();
+    }
+    block.m_name_size = name.size();
+#if defined(__linux__)
+    // Linux takes up to 15 characters
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+}
+
+std::string_view LogContext_C::GetThreadName() {
+    const ThreadBlock_TP& block = GetBlock();
+    return std::string_view(block.m_data)
+        .substr(block.m_id_size, block.m_name_size);
+}
+
+std::string_view LogContext_C::GetThreadId() {
+    const ThreadBlock_TP& block = GetBlock();
+    return std::string_view(block.m_data).substr(0, block.m_id_size);
+}
+
+void LogContext_C::Capture(LogRecord_TP& record) {
+    const ThreadBlock_TP& block = GetBlock();
+    record.m_thread_context = block.m_data;
+    record.m_thread_id_size = static_cast<uint16_t>(block.m_id_size);
+    record.m_thread_name_size = static_cast<uint16_t>(block.m_name_size);
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,177 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_context.h
+ *
+ * @brief LogContext_C keeps context attributes of a thread which are added to
+ * every log entry of the thread.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <string>
+#include <string_view>
+
+// Log includes
+#include "log_buffer.h"
+#include "log_record.h"
+#include "log_stream.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/** SN::Log::LogContext_C
+ *
+ * @b Description
+ * A stack of key=value attributes per thread, e.g. the robot, episode and
+ * task a simulation thread works on, rendered by the %X format token. The
+ * %I and %N tokens render the id and the name of the thread.
+ *
+ * An attribute is rendered to text once when it is pushed. The thread id,
+ * the thread name and the attributes are kept back to back in one block per
+ * thread, so a record refers to all of them with a single view and the
+ * async path copies them with a single memcpy.
+ *
+ * @b Rationale
+ * Repeating the same attributes in every message formats the same values
+ * again for every entry.
+ *
+ * @b Resource @b Ownership
+ * None, the blocks are thread local.
+ */
+class LogContext_C {
+   public:
+    /**
+     * Pushes an attribute, usually through SN_LOG_SCOPE_CONTEXT.
+     *
+     * @param key attribute name
+     * @param value rendered value
+     */
+    static void Push(std::string_view key, std::string_view value);
+
+    /**
+     * Pushes an attribute of any type LogStream_C can write.
+     *
+     * @param key attribute name
+     * @param value value, rendered now
+     */
+    template <typename Value_TP>
+    static void Push(std::string_view key, const Value_TP& value) {
+        LogBuffer_C buffer;
+        LogStream_C stream(buffer);
+        stream << value;
+        Push(key, buffer.View());
+    }
+
+    /**
+     * Removes the attribute pushed last.
+     */
+    static void Pop();
+
+    /**
+     * Gets the rendered attributes of the calling thread.
+     *
+     * @retval attributes as "key=value key=value", valid until the next
+     * change on this thread
+     */
+    static std::string_view GetContext();
+
+    /**
+     * Names the calling thread, in the log and where supported for the
+     * operating system. The name is read from the operating system
+     * otherwise.
+     *
+     * @param name thread name
+     */
+    static void SetThreadName(const std::string& name);
+
+    /**
+     * Gets the name of the calling thread.
+     *
+     * @retval thread name
+     */
+    static std::string_view GetThreadName();
+
+    /**
+     * Gets the rendered id of the calling thread, the kernel thread id on
+     * Linux.
+     *
+     * @retval thread id
+     */
+    static std::string_view GetThreadId();
+
+    /**
+     * Points a record to the block of the calling thread. The views stay
+     * valid until the next change on this thread, OwnPayload() copies them.
+     *
+     * @param record record to fill
+     */
+    static void Capture(LogRecord_TP& record);
+};  // end LogContext_C
+
+/** SN::Log::ScopedLogContext_C
+ *
+ * @b Description
+ * Pushes an attribute for the lifetime of the object, see
+ * SN_LOG_SCOPE_CONTEXT.
+ *
+ * @b Resource @b Ownership
+ * None
+ */
+class ScopedLogContext_C {
+   public:
+    template <typename Value_TP>
+    ScopedLogContext_C(std::string_view key, const Value_TP& value) {
+        LogContext_C::Push(key, value);
+    }
+
+    ~ScopedLogContext_C() { LogContext_C::Pop(); }
+
+    ScopedLogContext_C(const ScopedLogContext_C& rhs) = delete;
+    ScopedLogContext_C& operator=(const ScopedLogContext_C& rhs) = delete;
+};  // end ScopedLogContext_C
+
+}  // end namespace Log
+}  // end namespace SN
+
+#define SN_LOG_CONCAT_INNER(a, b) a##b
+#define SN_LOG_CONCAT(a, b) SN_LOG_CONCAT_INNER(a, b)
+
+/**
+ * Adds an attribute to the entries of the calling thread until the end of
+ * the enclosing scope, e.g. SN_LOG_SCOPE_CONTEXT("episode", episode).
+ *
+ * @param key attribute name
+ * @param value attribute value
+ */
+#define SN_LOG_SCOPE_CONTEXT(key, value)                                  \
+    SN::Log::ScopedLogContext_C SN_LOG_CONCAT(sn_log_context_, __LINE__)( \
+        key, value)
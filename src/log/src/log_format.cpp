@@ -0,0 +1,103 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_format.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+void AppendLiteral(std::vector<FormatOp_TP>& ops, char ch) {
+    if (ops.empty() || ops.back().m_kind != FormatOpKind_TP::LITERAL) {
+        ops.push_back({FormatOpKind_TP::LITERAL, std::string()});
+    }
+    ops.back().m_literal += ch;
+}
+
+void AppendOp(std::vector<FormatOp_TP>& ops, FormatOpKind_TP kind) {
+    ops.push_back({kind, std::string()});
+}
+
+}  // namespace
+
+LogFormat_C::LogFormat_C(const std::string& format)
+    : m_format(format), m_uses_thread_context(false) {
+    const char* format_ptr = m_format.c_str();
+    while (*format_ptr != 0) {
+        if (*format_ptr != '%') {
+            AppendLiteral(m_ops, *format_ptr++);
+            continue;
+        }
+        switch (*++format_ptr) {
+            case 0:
+                // A trailing '%' is kept as it is
+                AppendLiteral(m_ops, '%');
+                continue;
+            case '%':
+                AppendLiteral(m_ops, '%');
+                break;
+            case 'T':
+                AppendOp(m_ops, FormatOpKind_TP::TIME_STAMP);
+                break;
+            case 'F':
+                AppendOp(m_ops, FormatOpKind_TP::FILE);
+                break;
+            case 'C':
+                AppendOp(m_ops, FormatOpKind_TP::LINE);
+                break;
+            case 'P':
+                AppendOp(m_ops, FormatOpKind_TP::FUNCTION);
+                break;
+            case 'L':
+                AppendOp(m_ops, FormatOpKind_TP::LEVEL);
+                break;
+            case 'S':
+                AppendOp(m_ops, FormatOpKind_TP::MESSAGE);
+                break;
+            case 'R':
+                AppendOp(m_ops, FormatOpKind_TP::SAMPLE_RATE);
+                break;
+            case 'I':
+                AppendOp(m_ops, FormatOpKind_TP::THREAD_ID);
+                m_uses_thread_context = true;
+                break;
+            case 'N':
+                AppendOp(m_ops, FormatOpKind_TP::THREAD_NAME);
+                m_uses_thread_context = true;
+                break;
+            case 'X':
+                AppendOp(m_ops, FormatOpKind_TP::CONTEXT);
+                m_uses_thread_context = true;
+                break;
+            default:
+                break;
+        }
+        ++format_ptr;
+    }
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,125 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_format.h
+ *
+ * @brief LogFormat_C compiles a log format string into a list of operations.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <string>
+#include <vector>
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @enum FormatOpKind_TP
+ *
+ * @brief Kinds of operations a format string compiles into.
+ *
+ */
+enum class FormatOpKind_TP {
+    LITERAL = 0,      //!< Literal text between tokens(0)
+    TIME_STAMP = 1,   //!< %T time stamp(1)
+    FILE = 2,         //!< %F file name(2)
+    LINE = 3,         //!< %C line number(3)
+    FUNCTION = 4,     //!< %P function name(4)
+    LEVEL = 5,        //!< %L severity level(5)
+    MESSAGE = 6,      //!< %S message(6)
+    SAMPLE_RATE = 7,  //!< %R sampling rate(7)
+    THREAD_ID = 8,    //!< %I thread id(8)
+    THREAD_NAME = 9,  //!< %N thread name(9)
+    CONTEXT = 10      //!< %X context attributes of the thread(10)
+};
+
+/**
+ * @struct FormatOp_TP
+ *
+ * @brief A single operation of a compiled format.
+ *
+ */
+struct FormatOp_TP {
+    FormatOpKind_TP m_kind;  //!< operation kind
+    std::string m_literal;   //!< text of a LITERAL operation
+};
+
+/** SN::Log::LogFormat_C
+ *
+ * @b Description
+ * A format string parsed once into a flat list of operations so that writing
+ * a log entry does not have to scan the format string for every message.
+ * Adjacent literal characters are merged into a single operation and unknown
+ * tokens are dropped.
+ *
+ * @note
+ * The compiled format is immutable and is safe to share between threads.
+ */
+class LogFormat_C {
+   public:
+    /**
+     * Compiles a format string.
+     *
+     * @param format format string using the tokens of Logger_C::SetFormat()
+     */
+    explicit LogFormat_C(const std::string& format);
+
+    /**
+     * Gets the source format string
+     *
+     * @retval format string
+     */
+    const std::string& GetFormatString() const { return m_format; }
+
+    /**
+     * Gets the compiled operations
+     *
+     * @retval operations in output order
+     */
+    const std::vector<FormatOp_TP>& GetOps() const { return m_ops; }
+
+    /**
+     * Checks if the format renders the thread id, name or context, which the
+     * records then have to carry.
+     *
+     * @retval true if %I, %N or %X is used otherwise false
+     */
+    bool UsesThreadContext() const { return m_uses_thread_context; }
+
+   private:
+    std::string m_format;
+    std::vector<FormatOp_TP> m_ops;
+    bool m_uses_thread_context;
+};  // end LogFormat_C
+
+}  // end namespace Log
+}  // end namespace SN
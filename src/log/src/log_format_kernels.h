@@ -0,0 +1,394 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_format_kernels.h
+ *
+ * @brief Locale free number formatting straight into a character buffer.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SN_LOG_HAS_SSE2 1
+#endif
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * Formatting kernels used by the format ops of the logger and by LogStream_C.
+ *
+ * Every kernel writes into a caller provided buffer of at least the size
+ * given by the matching constant and returns the number of characters
+ * written. None of them allocates, takes a lock or looks at the locale.
+ */
+namespace Kernels {
+
+/** Buffer size for any 64 bit integer including the sign */
+constexpr size_t kMaxIntegerChars = 20;
+/** Buffer size for a hexadecimal 64 bit value including the "0x" prefix */
+constexpr size_t kMaxHexChars = 18;
+/** Buffer size for a shortest round trip double */
+constexpr size_t kMaxDoubleChars = 32;
+/** Highest precision accepted by FormatFixed() */
+constexpr int kMaxFixedPrecision = 17;
+/** Buffer size for a fixed precision double, larger values switch to the
+ * exponent form */
+constexpr size_t kMaxFixedChars = 48;
+
+/** "00" to "99", two digits are written per division by 100 */
+inline constexpr char kDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * Counts the decimal digits of a value.
+ *
+ * @param value value to count
+ * @retval number of digits, at least 1
+ */
+inline size_t CountDigits(uint64_t value) {
+    size_t digits = 1;
+    while (true) {
+        if (value < 10) return digits;
+        if (value < 100) return digits + 1;
+        if (value < 1000) return digits + 2;
+        if (value < 10000) return digits + 3;
+        value /= 10000;
+        digits += 4;
+    }
+}
+
+/**
+ * Writes an unsigned integer in decimal.
+ *
+ * @param value value to write
+ * @param buffer at least kMaxIntegerChars characters
+ * @retval number of characters written
+ */
+inline size_t FormatUnsigned(uint64_t value, char* buffer) {
+    size_t length = CountDigits(value);
+    char* out = buffer + length;
+    while (value >= 100) {
+        const char* pair = kDigitPairs + (value % 100) * 2;
+        value /= 100;
+        *--out = pair[1];
+        *--out = pair[0];
+    }
+    if (value >= 10) {
+        const char* pair = kDigitPairs + value * 2;
+        *--out = pair[1];
+        *--out = pair[0];
+    } else {
+        *--out = static_cast<char>('0' + value);
+    }
+    return length;
+}
+
+/**
+ * Writes a signed integer in decimal.
+ *
+ * @param value value to write
+ * @param buffer at least kMaxIntegerChars characters
+ * @retval number of characters written
+ */
+inline size_t FormatSigned(int64_t value, char* buffer) {
+    if (value >= 0) {
+        return FormatUnsigned(static_cast<uint64_t>(value), buffer);
+    }
+    *buffer = '-';
+    // Negate in unsigned arithmetic, -INT64_MIN overflows int64_t
+    return 1 + FormatUnsigned(0 - static_cast<uint64_t>(value), buffer + 1);
+}
+
+/**
+ * Writes a value in lower case hexadecimal without prefix.
+ *
+ * @param value value to write
+ * @param buffer at least kMaxHexChars characters
+ * @retval number of characters written
+ */
+inline size_t FormatHex(uint64_t value, char* buffer) {
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    size_t length = 1;
+    for (uint64_t rest = value >> 4; rest != 0; rest >>= 4) {
+        ++length;
+    }
+    for (char* out = buffer + length; out != buffer; value >>= 4) {
+        *--out = kHexDigits[value & 0xf];
+    }
+    return length;
+}
+
+/**
+ * Writes a pointer as "0x" followed by its address in hexadecimal.
+ *
+ * @param pointer pointer to write
+ * @param buffer at least kMaxHexChars characters
+ * @retval number of characters written
+ */
+inline size_t FormatPointer(const void* pointer, char* buffer) {
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    return 2 + FormatHex(reinterpret_cast<uintptr_t>(pointer), buffer + 2);
+}
+
+/**
+ * Gets the number of characters EncodeHex() writes.
+ *
+ * @param size number of bytes
+ * @retval buffer size
+ */
+constexpr size_t HexSize(size_t size) { return 2 * size; }
+
+/**
+ * Writes bytes as lower case hexadecimal, two characters per byte without
+ * separators. Sixteen bytes are converted per step where SSE2 is available.
+ *
+ * @param data bytes to write
+ * @param size number of bytes
+ * @param buffer at least HexSize(size) characters
+ * @retval number of characters written
+ */
+inline size_t EncodeHex(const uint8_t* data, size_t size, char* buffer) {
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    size_t i = 0;
+#ifdef SN_LOG_HAS_SSE2
+    const __m128i low_nibble = _mm_set1_epi8(0x0f);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero = _mm_set1_epi8('0');
+    // Distance from '9' + 1 to 'a'
+    const __m128i letter = _mm_set1_epi8('a' - '0' - 10);
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble);
+        __m128i low = _mm_and_si128(bytes, low_nibble);
+        high = _mm_add_epi8(_mm_add_epi8(high, zero),
+                            _mm_and_si128(_mm_cmpgt_epi8(high, nine), letter));
+        low = _mm_add_epi8(_mm_add_epi8(low, zero),
+                           _mm_and_si128(_mm_cmpgt_epi8(low, nine), letter));
+        // Interleave to high, low of each byte in order
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + 2 * i),
+                         _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + 2 * i + 16),
+                         _mm_unpackhi_epi8(high, low));
+    }
+#endif
+    for (; i < size; ++i) {
+        buffer[2 * i] = kHexDigits[data[i] >> 4];
+        buffer[2 * i + 1] = kHexDigits[data[i] & 0xf];
+    }
+    return HexSize(size);
+}
+
+/**
+ * Gets the number of characters EncodeBase64() writes.
+ *
+ * @param size number of bytes
+ * @retval buffer size
+ */
+constexpr size_t Base64Size(size_t size) { return (size + 2) / 3 * 4; }
+
+/**
+ * Writes bytes as standard base64 with padding.
+ *
+ * @param data bytes to write
+ * @param size number of bytes
+ * @param buffer at least Base64Size(size) characters
+ * @retval number of characters written
+ */
+inline size_t EncodeBase64(const uint8_t* data, size_t size, char* buffer) {
+    static constexpr char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    char* out = buffer;
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16 |
+                         static_cast<uint32_t>(data[i + 1]) << 8 | data[i + 2];
+        out[0] = kAlphabet[group >> 18];
+        out[1] = kAlphabet[(group >> 12) & 0x3f];
+        out[2] = kAlphabet[(group >> 6) & 0x3f];
+        out[3] = kAlphabet[group & 0x3f];
+        out += 4;
+    }
+    if (i < size) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < size) {
+            group |= static_cast<uint32_t>(data[i + 1]) << 8;
+        }
+        out[0] = kAlphabet[group >> 18];
+        out[1] = kAlphabet[(group >> 12) & 0x3f];
+        out[2] = i + 1 < size ? kAlphabet[(group >> 6) & 0x3f] : '=';
+        out[3] = '=';
+        out += 4;
+    }
+    return static_cast<size_t>(out - buffer);
+}
+
+/**
+ * Writes the shortest representation of a double which reads back to the
+ * same value, e.g. 0.1 as "0.1" rather than "0.10000000000000001".
+ *
+ * @param value value to write
+ * @param buffer at least kMaxDoubleChars characters
+ * @retval number of characters written
+ */
+inline size_t FormatDouble(double value, char* buffer) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    return static_cast<size_t>(
+        std::to_chars(buffer, buffer + kMaxDoubleChars, value).ptr - buffer);
+#else
+    // Without floating point to_chars: the fewest digits which round trip
+    int length = 0;
+    for (int precision = 15; precision <= 17; ++precision) {
+        length = std::snprintf(buffer, kMaxDoubleChars, "%.*g", precision,
+                               value);
+        if (precision == 17 || std::strtod(buffer, nullptr) == value) {
+            break;
+        }
+    }
+    return length > 0 ? static_cast<size_t>(length) : 0;
+#endif
+}
+
+/**
+ * Writes a double with a fixed number of decimals.
+ *
+ * @param value value to write
+ * @param precision number of decimals, clamped to kMaxFixedPrecision
+ * @param buffer at least kMaxFixedChars characters
+ * @retval number of characters written
+ */
+inline size_t FormatFixed(double value, int precision, char* buffer) {
+    if (precision < 0) {
+        precision = 0;
+    } else if (precision > kMaxFixedPrecision) {
+        precision = kMaxFixedPrecision;
+    }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::to_chars_result result =
+        std::to_chars(buffer, buffer + kMaxFixedChars, value,
+                      std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        return static_cast<size_t>(result.ptr - buffer);
+    }
+    // Too large for fixed notation in the buffer
+    return static_cast<size_t>(
+        std::to_chars(buffer, buffer + kMaxFixedChars, value,
+                      std::chars_format::scientific, precision)
+            .ptr -
+        buffer);
+#else
+    int length = std::snprintf(buffer, kMaxFixedChars, "%.*f", precision,
+                               value);
+    if (length < 0 || static_cast<size_t>(length) >= kMaxFixedChars) {
+        length = std::snprintf(buffer, kMaxFixedChars, "%.*e", precision,
+                               value);
+    }
+    return length > 0 ? static_cast<size_t>(length) : 0;
+#endif
+}
+
+/**
+ * Finds the first occurrence of a character, used by the tools that scan
+ * written logs. Sixteen bytes are compared per step where SSE2 is available.
+ *
+ * @param begin start of the text
+ * @param end end of the text
+ * @param ch character to find
+ * @retval position of the character, end if there is none
+ */
+inline const char* FindByte(const char* begin, const char* end, char ch) {
+    const char* pos = begin;
+#ifdef SN_LOG_HAS_SSE2
+    const __m128i needle = _mm_set1_epi8(ch);
+    for (; end - pos >= 16; pos += 16) {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)), needle));
+        if (mask != 0) {
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+    for (; pos != end; ++pos) {
+        if (*pos == ch) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+/**
+ * Finds the first occurrence of a text, candidates are located by
+ * FindByte() on its first character.
+ *
+ * @param begin start of the text to search
+ * @param end end of the text to search
+ * @param text text to find, not empty
+ * @param size number of characters of text
+ * @retval position of the text, end if there is none
+ */
+inline const char* FindText(const char* begin, const char* end,
+                            const char* text, size_t size) {
+    const char* pos = begin;
+    while (static_cast<size_t>(end - pos) >= size) {
+        pos = FindByte(pos, end - size + 1, text[0]);
+        if (pos == end - size + 1) {
+            break;
+        }
+        if (std::memcmp(pos + 1, text + 1, size - 1) == 0) {
+            return pos;
+        }
+        ++pos;
+    }
+    return end;
+}
+
+}  // end namespace Kernels
+
+}  // end namespace Log
+}  // end namespace SN
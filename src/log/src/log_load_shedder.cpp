@@ -0,0 +1,170 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_load_shedder.h"
+
+#include <algorithm>
+
+#include "log_clock.h"
+#include "log_format_kernels.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+LogLoadShedder_C::LogLoadShedder_C()
+    : m_level(static_cast<int>(LogSeverityLevel_TP::LOG_TRACE)),
+      m_peak_level(LogSeverityLevel_TP::LOG_TRACE),
+      m_low(false) {
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        m_shed[i] = 0;
+        m_reported[i] = 0;
+    }
+}
+
+uint64_t LogLoadShedder_C::GetShedCount(LogSeverityLevel_TP level) const {
+    return m_shed[static_cast<size_t>(level) % kLevelCount].load(
+        std::memory_order_relaxed);
+}
+
+bool LogLoadShedder_C::Observe(const LoadSheddingSettings_TP& settings,
+                               LogSeverityLevel_TP configured_level,
+                               double occupancy,
+                               std::chrono::nanoseconds latency,
+                               Clock_TP::time_point now) {
+    int level = m_level.load(std::memory_order_relaxed);
+    int configured = static_cast<int>(configured_level);
+    bool shedding = level != static_cast<int>(LogSeverityLevel_TP::LOG_TRACE);
+    if (!settings.m_enabled) {
+        return Restore();
+    }
+    bool high = occupancy >= settings.m_high_occupancy ||
+                latency >= settings.m_high_latency;
+    bool low = occupancy <= settings.m_low_occupancy &&
+               latency <= settings.m_low_latency;
+    int next = level;
+    if (high) {
+        m_low = false;
+        if (shedding && now - m_last_step < settings.m_step) {
+            return false;
+        }
+        next = std::min(std::max(level, configured) + 1,
+                        static_cast<int>(settings.m_max_level));
+        if (next <= std::max(level, configured)) {
+            // Already at the highest level shedding may raise to
+            return false;
+        }
+        if (!shedding) {
+            m_started = now;
+        }
+    } else if (!shedding) {
+        return false;
+    } else if (!low) {
+        // In between the marks, keep the level
+        m_low = false;
+        return false;
+    } else if (!m_low) {
+        m_low = true;
+        m_low_since = now;
+        return false;
+    } else if (now - m_low_since < settings.m_hold) {
+        return false;
+    } else {
+        // Every further step needs another hold of low pressure
+        m_low_since = now;
+        next = level - 1;
+        if (next <= configured) {
+            next = static_cast<int>(LogSeverityLevel_TP::LOG_TRACE);
+            m_ended = now;
+        }
+    }
+    m_last_step = now;
+    m_peak_level =
+        std::max(m_peak_level, static_cast<LogSeverityLevel_TP>(next));
+    m_level.store(next, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogLoadShedder_C::Restore() {
+    if (!IsShedding()) {
+        return false;
+    }
+    m_ended = Clock_TP::now();
+    m_low = false;
+    m_level.store(static_cast<int>(LogSeverityLevel_TP::LOG_TRACE),
+                  std::memory_order_relaxed);
+    return true;
+}
+
+bool LogLoadShedder_C::TakeSummary(LogRecord_TP& record) {
+    uint64_t shed[kLevelCount];
+    uint64_t total = 0;
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        uint64_t count = m_shed[i].load(std::memory_order_relaxed);
+        shed[i] = count - m_reported[i];
+        m_reported[i] = count;
+        total += shed[i];
+    }
+    if (m_peak_level == LogSeverityLevel_TP::LOG_TRACE) {
+        return false;
+    }
+    record.m_level = LogSeverityLevel_TP::LOG_WARN;
+    record.m_file = __FILE__;
+    record.m_function = __func__;
+    record.m_line = __LINE__;
+    record.m_time = LogClock_C::GetInstance()->Now();
+    char number[Kernels::kMaxIntegerChars];
+    record.m_buffer.Append("Load shedding raised the level up to ");
+    record.m_buffer.Append(ToString(m_peak_level));
+    record.m_buffer.Append(" for ");
+    int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     m_ended - m_started)
+                     .count();
+    record.m_buffer.Append(
+        number, Kernels::FormatUnsigned(static_cast<uint64_t>(ms), number));
+    record.m_buffer.Append(" ms and shed ");
+    record.m_buffer.Append(number, Kernels::FormatUnsigned(total, number));
+    record.m_buffer.Append(" log records");
+    const char* separator = " (";
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        if (shed[i] != 0) {
+            record.m_buffer.Append(separator);
+            record.m_buffer.Append(
+                ToString(static_cast<LogSeverityLevel_TP>(i)));
+            record.m_buffer.Append(": ");
+            record.m_buffer.Append(number,
+                                   Kernels::FormatUnsigned(shed[i], number));
+            separator = ", ";
+        }
+    }
+    if (total != 0) {
+        record.m_buffer.Append(')');
+    }
+    record.m_message = record.m_buffer.View();
+    m_peak_level = LogSeverityLevel_TP::LOG_TRACE;
+    return true;
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,162 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_load_shedder.h
+ *
+ * @brief LogLoadShedder_C raises the effective log level while the
+ * asynchronous logger is overloaded.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Log includes
+#include "log_record.h"
+#include "logging_attributes.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/** SN::Log::LogLoadShedder_C
+ *
+ * @b Description
+ * Decides from the queue occupancy and the write latency seen by the backend
+ * thread how far the effective minimum level is raised above the configured
+ * one. The level goes up by one step per m_step while pressure is high and
+ * down by one step per m_hold of low pressure, so a burst doesn't make it
+ * flap. Messages below the raised level are counted per level and reported
+ * in one WARN record once the configured level is back.
+ *
+ * @b Rationale
+ * During a fault storm the log volume rises exactly when the machine is
+ * busiest. Shedding the chatty levels keeps the logger from amplifying the
+ * overload while errors still get through.
+ *
+ * @note
+ * Observe() and TakeSummary() are called by the backend thread only, the
+ * level and the counters may be read and counted from any thread.
+ */
+class LogLoadShedder_C {
+   public:
+    using Clock_TP = std::chrono::steady_clock;
+
+    LogLoadShedder_C();
+
+    LogLoadShedder_C(const LogLoadShedder_C& rhs) = delete;
+    LogLoadShedder_C& operator=(const LogLoadShedder_C& rhs) = delete;
+
+    /**
+     * Gets the raised minimum level.
+     *
+     * @retval minimum level, LOG_TRACE when nothing is shed
+     */
+    LogSeverityLevel_TP GetLevel() const {
+        return static_cast<LogSeverityLevel_TP>(
+            m_level.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Checks if the level is raised.
+     *
+     * @retval true while shedding otherwise false
+     */
+    bool IsShedding() const {
+        return GetLevel() != LogSeverityLevel_TP::LOG_TRACE;
+    }
+
+    /**
+     * Counts a message suppressed by the raised level.
+     *
+     * @param level severity level of the message
+     */
+    void CountShed(LogSeverityLevel_TP level) {
+        m_shed[static_cast<size_t>(level) % kLevelCount].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the number of messages shed at a level since start.
+     *
+     * @param level log severity level
+     * @retval shed messages
+     */
+    uint64_t GetShedCount(LogSeverityLevel_TP level) const;
+
+    /**
+     * Feeds the pressure seen while writing one batch.
+     *
+     * @param settings shedding settings, disabled settings restore the level
+     * @param configured_level configured global minimum level
+     * @param occupancy share of the queue the batch took up
+     * @param latency average write time per record
+     * @param now time of the observation
+     * @retval true if the level has changed otherwise false
+     */
+    bool Observe(const LoadSheddingSettings_TP& settings,
+                 LogSeverityLevel_TP configured_level, double occupancy,
+                 std::chrono::nanoseconds latency, Clock_TP::time_point now);
+
+    /**
+     * Restores the configured level at once, e.g. when the backend stops.
+     *
+     * @retval true if the level was raised otherwise false
+     */
+    bool Restore();
+
+    /**
+     * Builds the WARN record telling how many messages have been shed since
+     * the last summary.
+     *
+     * @param record record to fill
+     * @retval true if there is anything to report otherwise false
+     */
+    bool TakeSummary(LogRecord_TP& record);
+
+   private:
+    static constexpr size_t kLevelCount = 6;
+
+    std::atomic<int> m_level;  //!< raised level, LOG_TRACE when off
+    std::atomic<uint64_t> m_shed[kLevelCount];
+    uint64_t m_reported[kLevelCount];  //!< backend thread only
+
+    LogSeverityLevel_TP m_peak_level;  //!< highest level of the episode
+    Clock_TP::time_point m_started;    //!< start of the episode
+    Clock_TP::time_point m_ended;      //!< end of the last episode
+    Clock_TP::time_point m_last_step;  //!< last change of the level
+    Clock_TP::time_point m_low_since;  //!< start of the low pressure
+    bool m_low;                        //!< pressure has been low since
+};  // end LogLoadShedder_C
+
+}  // end namespace Log
+}  // end namespace SN
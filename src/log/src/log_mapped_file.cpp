@@ -0,0 +1,95 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+LogMappedFile_C::~LogMappedFile_C() {
+#ifdef __linux__
+    if (m_data != nullptr) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+}
+
+bool LogMappedFile_C::Open(const std::string& file_name, std::string& error) {
+#ifdef __linux__
+    int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        error += "Couldn't open file " + file_name + ": " +
+                 std::strerror(errno) + "\n";
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    m_size = static_cast<size_t>(status.st_size);
+    if (m_size != 0) {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            error += "Couldn't map file " + file_name + ": " +
+                     std::strerror(errno) + "\n";
+            close(fd);
+            m_size = 0;
+            return false;
+        }
+        // Read once front to back
+        madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(data);
+    }
+    close(fd);
+    return true;
+#else
+    std::ifstream file(file_name.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        error += "Couldn't open file " + file_name + "\n";
+        return false;
+    }
+    m_copy.assign(std::istreambuf_iterator<char>(file),
+                  std::istreambuf_iterator<char>());
+    m_data = m_copy.data();
+    m_size = m_copy.size();
+    return true;
+#endif
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,95 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+
+/**
+ * @file log_mapped_file.h
+ *
+ * @brief Read only view of a whole log file for the offline tools.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/** SN::Log::LogMappedFile_C
+ *
+ * @b Description
+ * Maps a file read only into memory, so it can be scanned like a string.
+ *
+ * @note
+ * Uses mmap on Linux and reads the file into memory elsewhere.
+ *
+ * @b Resource @b Ownership
+ * Owns the mapping, the views handed out are valid until destruction.
+ */
+class LogMappedFile_C {
+   public:
+    LogMappedFile_C() = default;
+
+    /**
+     * Unmaps the file.
+     */
+    ~LogMappedFile_C();
+
+    LogMappedFile_C(const LogMappedFile_C& rhs) = delete;
+    LogMappedFile_C& operator=(const LogMappedFile_C& rhs) = delete;
+
+    /**
+     * Maps a file, the file is expected to be read once front to back.
+     *
+     * @param file_name file to map
+     * @param error description of the failure is appended
+     * @retval true on success otherwise false
+     */
+    bool Open(const std::string& file_name, std::string& error);
+
+    /**
+     * Gets the content of the file.
+     *
+     * @retval content, empty before Open()
+     */
+    std::string_view View() const { return std::string_view(m_data, m_size); }
+
+   private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+#ifndef __linux__
+    std::string m_copy;
+#endif
+};  // end LogMappedFile_C
+
+}  // end namespace Log
+}  // end namespace SN
@@ -23,36 +23,39 @@
 
 #include "logger.h"
 #include "log_message_sink.h"
+#include "log_site_profiler.h"
 
 namespace SN {
 namespace Log {
 
-LogMessageShink_C::LogMessageShink_C(LogSeverityLevel_TP level,
-                                     const std::string& file,
-                                     const std::string& func,
-                                     uint32_t line)
-    : m_log_severity_level(level),
-      m_file_name(file),
-      m_function_name(func),
-      m_line_number(line) {
-}
-
 LogMessageShink_C::LogMessageShink_C(const LogMessageShink_C& rhs)
     : m_log_severity_level(rhs.m_log_severity_level),
       m_file_name(rhs.m_file_name),
       m_function_name(rhs.m_function_name),
-      m_line_number(rhs.m_line_number) {
+      m_line_number(rhs.m_line_number),
+      m_sample_rate(rhs.m_sample_rate),
+      m_site_checked(rhs.m_site_checked),
+      m_profile(nullptr),
+      m_stream(m_buffer) {
 }
 
-LogMessageShink_C::~LogMessageShink_C() {
-  Logger_C::GetInstance()->LogWrite(m_log_severity_level,
-                                    m_file_name,
-                                    m_function_name,
-                                    m_line_number,
-                                    m_stream.str());
+void LogMessageShink_C::StartProfile() {
+  // Only counters handed over by this very site
+  if (m_profile->m_line != m_line_number || m_profile->m_file != m_file_name) {
+    m_profile = nullptr;
+    return;
+  }
+  m_start = LogClock_C::GetInstance()->Now();
 }
 
-std::ostream& LogMessageShink_C::GetStream() { return m_stream; }
+void LogMessageShink_C::StopProfile() {
+  LogTimePoint_TP end = LogClock_C::GetInstance()->Now();
+  int64_t format_ns = end.ToEpochNs() - m_start.ToEpochNs();
+  m_profile->m_bytes.fetch_add(m_buffer.Size(), std::memory_order_relaxed);
+  m_profile->m_format_ns.fetch_add(
+      format_ns > 0 ? static_cast<uint64_t>(format_ns) : 0,
+      std::memory_order_relaxed);
+}
 
 }  // namespace Log
 }  // namespace SN
@@ -23,8 +23,11 @@
 
 #pragma once
 
+#include "log_buffer.h"
+#include "log_clock.h"
+#include "log_site_profiler.h"
+#include "log_stream.h"
 #include "logging_attributes.h"
-#include <sstream>
 #include <string>
 
 class Logger_C;
@@ -32,26 +35,71 @@ class Logger_C;
 namespace SN {
 namespace Log {
 
+/**
+ * Collects one message and submits it to Logger_C when destroyed. Everything
+ * a log statement runs is inline, the destructor is defined in logger.h.
+ */
 class LogMessageShink_C {
  public:
   LogMessageShink_C(LogSeverityLevel_TP level,
-                    const std::string& file,
-                    const std::string& func,
-                    uint32_t line);
+                    const char* file,
+                    const char* func,
+                    uint32_t line,
+                    uint32_t sample_rate = 1,
+                    bool site_checked = false)
+      : m_log_severity_level(level),
+        m_file_name(file),
+        m_function_name(func),
+        m_line_number(line),
+        m_sample_rate(sample_rate),
+        m_site_checked(site_checked),
+        m_profile(nullptr),
+        m_stream(m_buffer) {
+    if (site_checked) {
+      m_profile = LogSiteProfiler_C::TakeCurrentSite();
+      if (m_profile != nullptr) {
+        StartProfile();
+      }
+    }
+  }
   LogMessageShink_C(const LogMessageShink_C& rhs);
-  ~LogMessageShink_C();
+  inline ~LogMessageShink_C();
 
-  std::ostream& GetStream();
+  LogStream_C& GetStream() { return m_stream; }
 
  private:
+  /** Takes the start time, or drops counters meant for another site */
+  void StartProfile();
+  /** Adds the bytes and the formatting time to the counters */
+  void StopProfile();
+
   LogSeverityLevel_TP m_log_severity_level; //! < Log severity level
 
-  std::string m_file_name;      //!< file name of log location
-  std::string m_function_name;  //!< function name of log location
+  const char* m_file_name;      //!< file name of log location
+  const char* m_function_name;  //!< function name of log location
   uint32_t m_line_number;       //!< line count of log location
+  uint32_t m_sample_rate;       //!< number of hits this record stands for
+  bool m_site_checked;          //!< level already checked by the call site
+  /** Counters of the call site while profiling, otherwise null */
+  LogSiteProfile_TP* m_profile;
+  LogTimePoint_TP m_start;  //!< construction time while profiling
 
-  std::ostringstream m_stream; //!< internal stream of the sink
+  LogBuffer_C m_buffer;  //!< pooled message buffer
+  LogStream_C m_stream;  //!< formats into m_buffer
+};
+
+/**
+ * Turns a log stream expression into void so that it can be used as one arm
+ * of a conditional expression. operator& binds looser than operator<<, so
+ * the whole stream chain is evaluated first.
+ */
+class LogMessageVoidify_C {
+ public:
+  void operator&(LogStream_C&) {}
 };
 
 }  // namespace Log
 }  // namespace SN
+
+// Defines ~LogMessageShink_C()
+#include "logger.h"
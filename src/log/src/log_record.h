@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_record.h
+ *
+ * @brief LogRecord_TP carries one unformatted log message from the point of
+ * log to the output.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <cstdint>
+#include <string_view>
+
+// Log includes
+#include "log_buffer.h"
+#include "log_clock.h"
+#include "logging_attributes.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct LogRecord_TP
+ *
+ * @brief A log message with its attributes, formatted at the output.
+ *
+ * The views either point into m_buffer or into storage which outlives the
+ * record, e.g. the __FILE__ and __func__ literals of the log macros.
+ *
+ */
+struct LogRecord_TP {
+    LogRecord_TP()
+        : m_level(LogSeverityLevel_TP::LOG_INFO),
+          m_line(0),
+          m_sample_rate(1),
+          m_thread_id_size(0),
+          m_thread_name_size(0) {}
+
+    LogRecord_TP(LogRecord_TP&& rhs) = default;
+    LogRecord_TP& operator=(LogRecord_TP&& rhs) = default;
+
+    /**
+     * Copies every view which does not point into m_buffer yet into it, so
+     * the record can outlive the caller's strings and thread.
+     */
+    void OwnPayload() {
+        if (!m_buffer.Empty()) {
+            // Built by LogMessageShink_C, only the message lives in the
+            // buffer and the location points to literals
+            if (!m_thread_context.empty()) {
+                size_t message = static_cast<size_t>(m_message.data() -
+                                                     m_buffer.Data());
+                size_t context = m_buffer.Size();
+                m_buffer.Append(m_thread_context);
+                m_message = std::string_view(m_buffer.Data() + message,
+                                             m_message.size());
+                m_thread_context = std::string_view(m_buffer.Data() + context,
+                                                    m_thread_context.size());
+            }
+            return;
+        }
+        size_t size = m_file.size() + m_function.size() + m_message.size() +
+                      m_thread_context.size();
+        char* data = m_buffer.Reserve(size);
+        m_buffer.Append(m_file);
+        m_buffer.Append(m_function);
+        m_buffer.Append(m_message);
+        m_buffer.Append(m_thread_context);
+        m_file = std::string_view(data, m_file.size());
+        data += m_file.size();
+        m_function = std::string_view(data, m_function.size());
+        data += m_function.size();
+        m_message = std::string_view(data, m_message.size());
+        data += m_message.size();
+        m_thread_context = std::string_view(data, m_thread_context.size());
+    }
+
+    /** Id of the logging thread, rendered by %I */
+    std::string_view ThreadId() const {
+        return m_thread_context.substr(0, m_thread_id_size);
+    }
+
+    /** Name of the logging thread, rendered by %N */
+    std::string_view ThreadName() const {
+        return m_thread_context.substr(m_thread_id_size, m_thread_name_size);
+    }
+
+    /** Context attributes of the logging thread, rendered by %X */
+    std::string_view Context() const {
+        return m_thread_context.substr(m_thread_id_size + m_thread_name_size);
+    }
+
+    LogSeverityLevel_TP m_level;  //!< log severity level
+    uint32_t m_line;              //!< line number at point of log
+    uint32_t m_sample_rate;       //!< number of hits the record stands for
+    LogTimePoint_TP m_time;       //!< raw time stamp at point of log
+    std::string_view m_file;      //!< file name at point of log
+    std::string_view m_function;  //!< function name at point of log
+    std::string_view m_message;   //!< message text
+    /** Thread id, thread name and context attributes, see LogContext_C */
+    std::string_view m_thread_context;
+    uint16_t m_thread_id_size;    //!< leading bytes of m_thread_context
+    uint16_t m_thread_name_size;  //!< bytes following the thread id
+    LogBuffer_C m_buffer;         //!< storage owned by the record
+};
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,291 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_record_pool.h"
+
+#include <cstring>
+#include <new>
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+/** Slabs a thread keeps before handing the surplus to the shared list */
+constexpr size_t kMaxCachedSlabs = 256;
+/** Slabs a thread takes from the shared list at once */
+constexpr size_t kRefillBatch = 32;
+/** Size class index of blocks allocated at their exact size */
+constexpr uint32_t kOversizeClass = 3;
+
+}  // namespace
+
+/** SN::Log::SlabCache_C
+ *
+ * @b Description
+ * Free slabs of one thread. m_free is touched by the owning thread only,
+ * m_remote collects slabs released by other threads.
+ */
+class SlabCache_C {
+   public:
+    SlabCache_C() : m_free(nullptr), m_free_count(0), m_remote(nullptr),
+                    m_next_retired(nullptr) {}
+
+    void Push(LogSlab_TP* slab) {
+        slab->m_next = m_free;
+        m_free = slab;
+        ++m_free_count;
+    }
+
+    LogSlab_TP* Pop() {
+        LogSlab_TP* slab = m_free;
+        if (slab != nullptr) {
+            m_free = slab->m_next;
+            --m_free_count;
+        }
+        return slab;
+    }
+
+    void PushRemote(LogSlab_TP* slab) {
+        // Only the owner takes from m_remote and it always takes the whole
+        // list, so a plain CAS push is free of ABA issues
+        LogSlab_TP* head = m_remote.load(std::memory_order_relaxed);
+        do {
+            slab->m_next = head;
+        } while (!m_remote.compare_exchange_weak(head, slab,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    }
+
+    void DrainRemote() {
+        LogSlab_TP* slab = m_remote.exchange(nullptr, std::memory_order_acquire);
+        while (slab != nullptr) {
+            LogSlab_TP* next = slab->m_next;
+            Push(slab);
+            slab = next;
+        }
+    }
+
+    void Retire() { LogRecordPool_C::GetInstance()->RetireCache(this); }
+
+    LogSlab_TP* m_free;
+    size_t m_free_count;
+    std::atomic<LogSlab_TP*> m_remote;
+    SlabCache_C* m_next_retired;
+};
+
+namespace {
+
+/** Hands the cache back to the pool when its thread exits */
+struct ThreadCacheHolder_TP {
+    SlabCache_C* m_cache = nullptr;
+    ~ThreadCacheHolder_TP();
+};
+
+thread_local ThreadCacheHolder_TP t_cache_holder;
+
+ThreadCacheHolder_TP::~ThreadCacheHolder_TP() {
+    if (m_cache != nullptr) {
+        m_cache->Retire();
+        m_cache = nullptr;
+    }
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& stream, const LogPoolStats_TP& stats) {
+    return stream << "in use: " << stats.m_in_use
+                  << ", high water mark: " << stats.m_high_water_mark
+                  << ", allocated: " << stats.m_allocated
+                  << ", fallback " << LogRecordPool_C::kSizeClasses[0]
+                  << ": " << stats.m_fallback[0] << ", fallback "
+                  << LogRecordPool_C::kSizeClasses[1] << ": "
+                  << stats.m_fallback[1] << ", oversize: " << stats.m_oversize;
+}
+
+LogRecordPool_C::LogRecordPool_C()
+    : m_free_lists{nullptr, nullptr, nullptr},
+      m_retired_caches(nullptr),
+      m_in_use(0),
+      m_high_water_mark(0),
+      m_allocated(0),
+      m_fallback{{0}, {0}},
+      m_oversize(0) {}
+
+LogRecordPool_C* LogRecordPool_C::GetInstance() {
+    // Never destroyed, records may still be released from thread exit and
+    // static destructors
+    static LogRecordPool_C* instance = new LogRecordPool_C();
+    return instance;
+}
+
+SlabCache_C* LogRecordPool_C::GetThreadCache() {
+    SlabCache_C* cache = t_cache_holder.m_cache;
+    if (cache == nullptr) {
+        cache = AdoptCache();
+        t_cache_holder.m_cache = cache;
+    }
+    return cache;
+}
+
+SlabCache_C* LogRecordPool_C::AdoptCache() {
+    {
+        std::lock_guard<std::mutex> lock(m_free_list_mutex);
+        if (m_retired_caches != nullptr) {
+            SlabCache_C* cache = m_retired_caches;
+            m_retired_caches = cache->m_next_retired;
+            cache->m_next_retired = nullptr;
+            return cache;
+        }
+    }
+    return new SlabCache_C();
+}
+
+void LogRecordPool_C::RetireCache(SlabCache_C* cache) {
+    cache->DrainRemote();
+    std::lock_guard<std::mutex> lock(m_free_list_mutex);
+    while (LogSlab_TP* slab = cache->Pop()) {
+        slab->m_next = m_free_lists[0];
+        m_free_lists[0] = slab;
+    }
+    cache->m_next_retired = m_retired_caches;
+    m_retired_caches = cache;
+}
+
+LogSlab_TP* LogRecordPool_C::NewSlab(uint32_t size_class, size_t capacity) {
+    void* memory = ::operator new(sizeof(LogSlab_TP) + capacity);
+    LogSlab_TP* slab = static_cast<LogSlab_TP*>(memory);
+    slab->m_next = nullptr;
+    slab->m_owner = nullptr;
+    slab->m_size_class = size_class;
+    slab->m_capacity = static_cast<uint32_t>(capacity);
+    m_allocated.fetch_add(1, std::memory_order_relaxed);
+    return slab;
+}
+
+void LogRecordPool_C::CountAcquire() {
+    int64_t in_use = m_in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+    int64_t high = m_high_water_mark.load(std::memory_order_relaxed);
+    while (in_use > high &&
+           !m_high_water_mark.compare_exchange_weak(
+               high, in_use, std::memory_order_relaxed)) {
+    }
+}
+
+LogSlab_TP* LogRecordPool_C::Acquire(size_t size) {
+    LogSlab_TP* slab = nullptr;
+    if (size <= kSlabSize) {
+        SlabCache_C* cache = GetThreadCache();
+        slab = cache->Pop();
+        if (slab == nullptr) {
+            cache->DrainRemote();
+            slab = cache->Pop();
+        }
+        if (slab == nullptr) {
+            std::lock_guard<std::mutex> lock(m_free_list_mutex);
+            for (size_t i = 0; i < kRefillBatch && m_free_lists[0]; ++i) {
+                LogSlab_TP* shared = m_free_lists[0];
+                m_free_lists[0] = shared->m_next;
+                cache->Push(shared);
+            }
+            slab = cache->Pop();
+        }
+        if (slab == nullptr) {
+            slab = NewSlab(0, kSlabSize);
+        }
+        slab->m_owner = cache;
+    } else if (size <= kSizeClasses[1]) {
+        uint32_t size_class = size <= kSizeClasses[0] ? 1 : 2;
+        m_fallback[size_class - 1].fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_free_list_mutex);
+            slab = m_free_lists[size_class];
+            if (slab != nullptr) {
+                m_free_lists[size_class] = slab->m_next;
+            }
+        }
+        if (slab == nullptr) {
+            slab = NewSlab(size_class, kSizeClasses[size_class - 1]);
+        }
+    } else {
+        m_oversize.fetch_add(1, std::memory_order_relaxed);
+        slab = NewSlab(kOversizeClass, size);
+    }
+    CountAcquire();
+    return slab;
+}
+
+void LogRecordPool_C::Release(LogSlab_TP* slab) {
+    m_in_use.fetch_sub(1, std::memory_order_relaxed);
+    if (slab->m_size_class == 0) {
+        SlabCache_C* cache = t_cache_holder.m_cache;
+        if (slab->m_owner != cache || cache == nullptr) {
+            slab->m_owner->PushRemote(slab);
+            return;
+        }
+        cache->Push(slab);
+        if (cache->m_free_count > kMaxCachedSlabs) {
+            // Hand half of the surplus over to threads that need slabs
+            std::lock_guard<std::mutex> lock(m_free_list_mutex);
+            while (cache->m_free_count > kMaxCachedSlabs / 2) {
+                LogSlab_TP* surplus = cache->Pop();
+                surplus->m_next = m_free_lists[0];
+                m_free_lists[0] = surplus;
+            }
+        }
+    } else if (slab->m_size_class == kOversizeClass) {
+        m_allocated.fetch_sub(1, std::memory_order_relaxed);
+        ::operator delete(slab);
+    } else {
+        std::lock_guard<std::mutex> lock(m_free_list_mutex);
+        slab->m_next = m_free_lists[slab->m_size_class];
+        m_free_lists[slab->m_size_class] = slab;
+    }
+}
+
+void LogRecordPool_C::Reserve(size_t count) {
+    SlabCache_C* cache = GetThreadCache();
+    while (cache->m_free_count < count) {
+        LogSlab_TP* slab = NewSlab(0, kSlabSize);
+        // Touch the payload so the first record does not page fault
+        std::memset(slab->Data(), 0, slab->m_capacity);
+        slab->m_owner = cache;
+        cache->Push(slab);
+    }
+}
+
+LogPoolStats_TP LogRecordPool_C::GetStats() const {
+    LogPoolStats_TP stats;
+    stats.m_in_use = m_in_use.load(std::memory_order_relaxed);
+    stats.m_high_water_mark = m_high_water_mark.load(std::memory_order_relaxed);
+    stats.m_allocated = m_allocated.load(std::memory_order_relaxed);
+    stats.m_fallback[0] = m_fallback[0].load(std::memory_order_relaxed);
+    stats.m_fallback[1] = m_fallback[1].load(std::memory_order_relaxed);
+    stats.m_oversize = m_oversize.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // end namespace Log
+}  // end namespace SN
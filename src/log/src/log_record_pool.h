@@ -0,0 +1,189 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_record_pool.h
+ *
+ * @brief LogRecordPool_C recycles the memory of log records and formatted
+ * payloads so steady state logging does not call the global allocator.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+class SlabCache_C;
+
+/**
+ * @struct LogSlab_TP
+ *
+ * @brief Header of a pooled memory block, the payload follows the header.
+ *
+ */
+struct LogSlab_TP {
+    LogSlab_TP* m_next;     //!< free list link
+    SlabCache_C* m_owner;   //!< thread cache of a thread slab
+    uint32_t m_size_class;  //!< index into the size classes
+    uint32_t m_capacity;    //!< payload capacity in bytes
+
+    char* Data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+/**
+ * @struct LogPoolStats_TP
+ *
+ * @brief Occupancy and fallback counters of the record pool.
+ *
+ */
+struct LogPoolStats_TP {
+    int64_t m_in_use;           //!< blocks currently handed out
+    int64_t m_high_water_mark;  //!< maximum of m_in_use so far
+    int64_t m_allocated;        //!< blocks obtained from the allocator
+    /** Acquisitions served by each size class above the thread slabs */
+    int64_t m_fallback[2];
+    int64_t m_oversize;  //!< acquisitions too large for any size class
+};
+
+/**
+ * Stream operator<< for the pool statistics
+ *
+ * @param stream output stream
+ * @param stats pool statistics
+ *
+ * @retval output stream
+ *
+ */
+std::ostream& operator<<(std::ostream& stream, const LogPoolStats_TP& stats);
+
+/** SN::Log::LogRecordPool_C
+ *
+ * @b Description
+ * Hands out memory blocks for log records. Requests up to the slab size are
+ * served from a free list owned by the calling thread, so the common case
+ * takes no lock. A slab released by another thread, e.g. the one writing the
+ * record out, is pushed onto a lock free list of its owner and picked up by
+ * the owner once its local list runs dry.
+ *
+ * Larger requests fall back to size classes shared between threads behind a
+ * mutex, and requests beyond the largest class go to the global allocator.
+ * Both are counted so that a badly sized slab shows up in the statistics.
+ *
+ * @b Resource @b Ownership
+ * The pool owns every block it ever allocated. Blocks are recycled, never
+ * freed, except oversized ones which are freed on release.
+ *
+ * @note
+ * Thread caches outlive their threads, a new thread adopts the cache of an
+ * exited one, so slabs in flight always have a valid owner to return to.
+ */
+class LogRecordPool_C {
+   private:
+    /**
+     * Construct a pool
+     */
+    LogRecordPool_C();
+
+   public:
+    /** Payload size of a thread slab */
+    static constexpr size_t kSlabSize = 512;
+    /** Payload sizes of the shared size classes */
+    static constexpr size_t kSizeClasses[2] = {4096, 32768};
+
+    LogRecordPool_C(const LogRecordPool_C& rhs) = delete;
+    LogRecordPool_C& operator=(const LogRecordPool_C& rhs) = delete;
+
+    /**
+     * Get the singleton object of the pool.
+     *
+     * @retval pool object
+     */
+    static LogRecordPool_C* GetInstance();
+
+    /**
+     * Acquires a block.
+     *
+     * @param size minimum payload size
+     * @retval block with a capacity of at least size bytes
+     */
+    LogSlab_TP* Acquire(size_t size);
+
+    /**
+     * Returns a block to the pool, from any thread.
+     *
+     * @param slab block to release
+     */
+    void Release(LogSlab_TP* slab);
+
+    /**
+     * Allocates slabs into the cache of the calling thread ahead of time.
+     *
+     * @param count number of slabs the cache should hold at least
+     */
+    void Reserve(size_t count);
+
+    /**
+     * Gets the pool statistics.
+     *
+     * @retval statistics snapshot
+     */
+    LogPoolStats_TP GetStats() const;
+
+   private:
+    friend class SlabCache_C;
+
+    SlabCache_C* GetThreadCache();
+    SlabCache_C* AdoptCache();
+    void RetireCache(SlabCache_C* cache);
+    LogSlab_TP* NewSlab(uint32_t size_class, size_t capacity);
+    void CountAcquire();
+
+    /** Shared free lists: thread slabs returned from full caches, then the
+     * size classes */
+    LogSlab_TP* m_free_lists[3];
+    std::mutex m_free_list_mutex;
+    /** Caches of exited threads waiting to be adopted */
+    SlabCache_C* m_retired_caches;
+
+    std::atomic<int64_t> m_in_use;
+    std::atomic<int64_t> m_high_water_mark;
+    std::atomic<int64_t> m_allocated;
+    std::atomic<int64_t> m_fallback[2];
+    std::atomic<int64_t> m_oversize;
+};  // end LogRecordPool_C
+
+}  // end namespace Log
+}  // end namespace SN
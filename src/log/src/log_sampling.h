@@ -0,0 +1,255 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_sampling.h
+ *
+ * @brief Sampling helpers and macros for high-rate log call sites.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// Log includes
+#include "log_site_profiler.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct EveryTSamplerState_TP
+ *
+ * @brief Per call-site state of the time based sampler.
+ *
+ */
+struct EveryTSamplerState_TP {
+    std::atomic<int64_t> m_next_ns{0};  //!< earliest time of the next record
+    std::atomic<uint32_t> m_hits{0};    //!< hits since the last record
+};
+
+/**
+ * Sampling decisions used by the SN_LOG_EVERY_N family of macros.
+ *
+ * Every sampler returns zero when the call site has to be skipped, otherwise
+ * the sampling rate carried by the emitted record, i.e. the number of hits
+ * that record stands for.
+ */
+namespace Sampling {
+
+/**
+ * Lets one out of every n hits of a call site through.
+ *
+ * @param counter per call-site hit counter
+ * @param n sampling period
+ * @retval sampling rate of the record or zero if it must be skipped
+ */
+inline uint32_t EveryN(std::atomic<uint64_t>& counter, uint32_t n) {
+    uint64_t hit = counter.fetch_add(1, std::memory_order_relaxed);
+    if (n <= 1) {
+        return 1;
+    }
+    return (hit % n == 0) ? n : 0;
+}
+
+/**
+ * Lets the first n hits of a call site through.
+ *
+ * @param counter per call-site hit counter
+ * @param n number of records to emit
+ * @retval sampling rate of the record or zero if it must be skipped
+ */
+inline uint32_t FirstN(std::atomic<uint64_t>& counter, uint32_t n) {
+    // Plain load first so the counter stops bouncing between cores once the
+    // site is exhausted
+    if (counter.load(std::memory_order_relaxed) >= n) {
+        return 0;
+    }
+    return (counter.fetch_add(1, std::memory_order_relaxed) < n) ? 1 : 0;
+}
+
+/**
+ * Lets at most one hit of a call site through per period.
+ *
+ * @param state per call-site sampler state
+ * @param period_ms sampling period in milliseconds
+ * @retval number of hits since the previous record or zero if it must be
+ * skipped
+ */
+inline uint32_t EveryT(EveryTSamplerState_TP& state, uint32_t period_ms) {
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    using std::chrono::steady_clock;
+    state.m_hits.fetch_add(1, std::memory_order_relaxed);
+    int64_t now =
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+            .count();
+    int64_t next = state.m_next_ns.load(std::memory_order_relaxed);
+    if (now < next) {
+        return 0;
+    }
+    int64_t period_ns = static_cast<int64_t>(period_ms) * 1000000;
+    if (!state.m_next_ns.compare_exchange_strong(next, now + period_ns,
+                                                 std::memory_order_relaxed)) {
+        // Another thread won this period
+        return 0;
+    }
+    uint32_t hits = state.m_hits.exchange(0, std::memory_order_relaxed);
+    return hits != 0 ? hits : 1;
+}
+
+/**
+ * Lets a random fraction of the hits of a call site through.
+ *
+ * Uses a thread local xorshift generator, so there is no shared state and
+ * no contention between threads hitting the same site.
+ *
+ * @param fraction probability of a hit being logged, in [0, 1]
+ * @retval sampling rate of the record or zero if it must be skipped
+ */
+inline uint32_t Fraction(double fraction) {
+    if (fraction >= 1.0) {
+        return 1;
+    }
+    if (!(fraction > 0.0)) {
+        return 0;
+    }
+    thread_local uint64_t state =
+        (std::hash<std::thread::id>()(std::this_thread::get_id()) |
+         1) * 0x9E3779B97F4A7C15ULL;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    uint64_t rand = state * 0x2545F4914F6CDD1DULL;
+    // Top 53 bits mapped onto [0, 1)
+    if (static_cast<double>(rand >> 11) * 0x1p-53 >= fraction) {
+        return 0;
+    }
+    return static_cast<uint32_t>(1.0 / fraction + 0.5);
+}
+
+/**
+ * Passes the rate of a sampler on. The call site has already handed its
+ * profiler counters to the next message, so a rejected hit takes them back.
+ *
+ * @param rate sampling rate or zero to skip
+ * @retval rate
+ */
+inline uint32_t Checked(uint32_t rate) {
+    if (rate == 0) {
+        LogSiteProfiler_C::RejectCurrentSite();
+    }
+    return rate;
+}
+
+}  // end namespace Sampling
+
+}  // end namespace Log
+}  // end namespace SN
+
+/**
+ * Per call-site static sampler state. The lambda gives every expansion its
+ * own function local static without requiring a declaration statement.
+ *
+ * @param type type of the sampler state
+ */
+#define SN_LOG_SAMPLER_STATE(type) \
+    ([]() -> type& {               \
+        static type sn_state;      \
+        return sn_state;           \
+    }())
+
+/**
+ * Logs through SN_LOG when the sampler accepts the hit. The severity level is
+ * checked first, against the cached decision of the call site, so a disabled
+ * site never touches the sampler state, and the sampler runs before any
+ * LogMessageShink_C is constructed. For LogSiteProfiler_C a rejected hit
+ * counts as filtered.
+ *
+ * @param level severity level to log at
+ * @param sampler expression returning the sampling rate or zero to skip
+ */
+#define SN_LOG_SAMPLED(level, sampler)                                     \
+    if (uint32_t sn_sample_rate =                                          \
+            SN_LOG_SITE_ENABLED(level)                                     \
+                ? SN::Log::Sampling::Checked(sampler)                      \
+                : 0u;                                                      \
+        sn_sample_rate == 0u) {                                            \
+    } else                                                                 \
+        SN::Log::LogMessageShink_C(level, __FILE__, __FUNCTION_NAME__,     \
+                                   __LINE__, sn_sample_rate, true)         \
+            .GetStream()
+
+/**
+ * Logs one out of every n hits of the call site.
+ *
+ * @param level severity level to log at
+ * @param n sampling period
+ */
+#define SN_LOG_EVERY_N(level, n)                                          \
+    SN_LOG_SAMPLED(level, SN::Log::Sampling::EveryN(                      \
+                              SN_LOG_SAMPLER_STATE(std::atomic<uint64_t>), \
+                              (n)))
+
+/**
+ * Logs the first n hits of the call site only.
+ *
+ * @param level severity level to log at
+ * @param n number of records to emit
+ */
+#define SN_LOG_FIRST_N(level, n)                                          \
+    SN_LOG_SAMPLED(level, SN::Log::Sampling::FirstN(                      \
+                              SN_LOG_SAMPLER_STATE(std::atomic<uint64_t>), \
+                              (n)))
+
+/**
+ * Logs at most one hit of the call site every ms milliseconds.
+ *
+ * @param level severity level to log at
+ * @param ms sampling period in milliseconds
+ */
+#define SN_LOG_EVERY_T(level, ms)                                     \
+    SN_LOG_SAMPLED(level, SN::Log::Sampling::EveryT(                  \
+                              SN_LOG_SAMPLER_STATE(                   \
+                                  SN::Log::EveryTSamplerState_TP),    \
+                              (ms)))
+
+/**
+ * Logs a random fraction of the hits of the call site.
+ *
+ * @param level severity level to log at
+ * @param fraction probability of a hit being logged, in [0, 1]
+ */
+#define SN_LOG_SAMPLE(level, fraction) \
+    SN_LOG_SAMPLED(level, SN::Log::Sampling::Fraction(fraction))
@@ -0,0 +1,423 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_shm_ring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SN_LOG_HAS_SHM 1
+#endif
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+constexpr uint32_t kShmMagic = 0x534e4c47;  // "SNLG"
+constexpr uint32_t kShmVersion = 2;
+constexpr size_t kCacheLine = 64;
+
+// A slot being written holds kWriting, the writer's pid and the low half of
+// the position in its sequence, see ShmSlot_TP
+constexpr uint64_t kWriting = uint64_t{1} << 63;
+constexpr uint64_t kPositionMask = 0xffffffff;
+
+uint64_t WritingSequence(uint64_t position, uint32_t pid) {
+    return kWriting | (uint64_t{pid & 0x7fffffff} << 32) |
+           (position & kPositionMask);
+}
+
+bool IsWriting(uint64_t sequence) { return (sequence & kWriting) != 0; }
+
+/** Whether a slot being written belongs to the lap of the position */
+bool IsWritingFor(uint64_t sequence, uint64_t position) {
+    return (sequence & kPositionMask) == (position & kPositionMask);
+}
+
+uint32_t WriterPid(uint64_t sequence) {
+    return static_cast<uint32_t>((sequence & ~kWriting) >> 32);
+}
+
+uint32_t CurrentPid() {
+#ifdef SN_LOG_HAS_SHM
+    return static_cast<uint32_t>(getpid());
+#else
+    return 0;
+#endif
+}
+
+/** Whether the process is known to be gone, a pid reused since looks alive */
+bool IsProcessGone(uint32_t pid) {
+#ifdef SN_LOG_HAS_SHM
+    return pid != 0 && kill(static_cast<pid_t>(pid), 0) != 0 &&
+           errno == ESRCH;
+#else
+    (void)pid;
+    return false;
+#endif
+}
+
+size_t RoundUpPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+}  // namespace
+
+/**
+ * @struct ShmRingHeader_TP
+ *
+ * @brief Layout of the start of the shared memory object, followed by the
+ * slots. The positions sit on cache lines of their own, they are written by
+ * different processes.
+ *
+ */
+struct ShmRingHeader_TP {
+    std::atomic<uint32_t> m_magic;  //!< set last by the creator
+    uint32_t m_version;
+    uint64_t m_capacity;
+    uint64_t m_slot_size;
+    alignas(kCacheLine) std::atomic<uint64_t> m_enqueue_position;
+    alignas(kCacheLine) std::atomic<uint64_t> m_dequeue_position;
+    alignas(kCacheLine) std::atomic<uint64_t> m_dropped;
+};
+
+/**
+ * @struct ShmSlot_TP
+ *
+ * @brief Header of a slot, followed by the entry.
+ *
+ * m_sequence equals the position when the slot is free for a producer and
+ * the position + 1 when it holds an entry for the consumer. In between, the
+ * producer which claimed the position owns the slot and marks it as being
+ * written, see WritingSequence(). Nobody else touches the entry then.
+ *
+ */
+struct ShmSlot_TP {
+    std::atomic<uint64_t> m_sequence;
+    uint32_t m_pid;
+    uint32_t m_size;
+    uint8_t m_level;
+    uint8_t m_truncated;
+
+    char* Data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "The ring needs address free 64 bit atomics");
+
+std::unique_ptr<ShmLogRing_C> ShmLogRing_C::Open(const std::string& name,
+                                                 size_t capacity,
+                                                 size_t slot_size,
+                                                 std::string& error) {
+#ifdef SN_LOG_HAS_SHM
+    capacity = RoundUpPowerOfTwo(capacity < 2 ? 2 : capacity);
+    // Room for the header plus a useful entry, kept 8 byte aligned
+    slot_size =
+        (std::max(slot_size, sizeof(ShmSlot_TP) + 64) + 7) & ~size_t(7);
+
+    bool created = true;
+    // Entries may hold anything the processes log, so only their user may
+    // read or write the ring
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = shm_open(name.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        error = "shm_open(" + name + ") failed: " + std::strerror(errno);
+        return nullptr;
+    }
+
+    size_t mapped_size = 0;
+    if (created) {
+        mapped_size = sizeof(ShmRingHeader_TP) + capacity * slot_size;
+        if (ftruncate(fd, static_cast<off_t>(mapped_size)) != 0) {
+            error = "ftruncate failed: " + std::string(std::strerror(errno));
+            close(fd);
+            Unlink(name);
+            return nullptr;
+        }
+    } else {
+        // The creator may still be sizing the object
+        struct stat status;
+        for (int attempt = 0; attempt < 1000; ++attempt) {
+            if (fstat(fd, &status) == 0 &&
+                static_cast<size_t>(status.st_size) >=
+                    sizeof(ShmRingHeader_TP)) {
+                mapped_size = static_cast<size_t>(status.st_size);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (mapped_size == 0) {
+            error = "shared memory object " + name + " is not initialized";
+            close(fd);
+            return nullptr;
+        }
+    }
+
+    void* memory =
+        mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        error = "mmap failed: " + std::string(std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+    std::unique_ptr<ShmLogRing_C> ring(
+        new ShmLogRing_C(fd, memory, mapped_size));
+    ShmRingHeader_TP* header = ring->m_header;
+
+    if (created) {
+        header->m_version = kShmVersion;
+        header->m_capacity = capacity;
+        header->m_slot_size = slot_size;
+        header->m_enqueue_position.store(0, std::memory_order_relaxed);
+        header->m_dequeue_position.store(0, std::memory_order_relaxed);
+        header->m_dropped.store(0, std::memory_order_relaxed);
+        ring->m_capacity = capacity;
+        ring->m_slot_size = slot_size;
+        for (size_t i = 0; i < capacity; ++i) {
+            ring->Slot(i)->m_sequence.store(i, std::memory_order_relaxed);
+        }
+        // Publishes the initialized ring to the other processes
+        header->m_magic.store(kShmMagic, std::memory_order_release);
+    } else {
+        for (int attempt = 0; attempt < 1000 &&
+                              header->m_magic.load(std::memory_order_acquire) !=
+                                  kShmMagic;
+             ++attempt) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (header->m_magic.load(std::memory_order_acquire) != kShmMagic ||
+            header->m_version != kShmVersion ||
+            sizeof(ShmRingHeader_TP) +
+                    header->m_capacity * header->m_slot_size >
+                mapped_size) {
+            error = "shared memory object " + name + " is not a log ring";
+            return nullptr;
+        }
+        ring->m_capacity = header->m_capacity;
+        ring->m_slot_size = header->m_slot_size;
+    }
+    return ring;
+#else
+    (void)capacity;
+    (void)slot_size;
+    error = "shared memory logging is not supported on this platform (" +
+            name + ")";
+    return nullptr;
+#endif
+}
+
+void ShmLogRing_C::Unlink(const std::string& name) {
+#ifdef SN_LOG_HAS_SHM
+    shm_unlink(name.c_str());
+#else
+    (void)name;
+#endif
+}
+
+ShmLogRing_C::ShmLogRing_C(int fd, void* memory, size_t mapped_size)
+    : m_fd(fd),
+      m_memory(memory),
+      m_mapped_size(mapped_size),
+      m_header(static_cast<ShmRingHeader_TP*>(memory)),
+      m_capacity(0),
+      m_slot_size(0),
+      m_consumer(false),
+      m_stall_timeout(1000),
+      m_stall_position(UINT64_MAX) {}
+
+ShmLogRing_C::~ShmLogRing_C() {
+#ifdef SN_LOG_HAS_SHM
+    munmap(m_memory, m_mapped_size);
+    // Closing the descriptor also releases the consumer lock
+    close(m_fd);
+#endif
+}
+
+ShmSlot_TP* ShmLogRing_C::Slot(uint64_t position) const {
+    char* slots = static_cast<char*>(m_memory) + sizeof(ShmRingHeader_TP);
+    return reinterpret_cast<ShmSlot_TP*>(
+        slots + (position & (m_capacity - 1)) * m_slot_size);
+}
+
+bool ShmLogRing_C::TryPush(LogSeverityLevel_TP level, const char* entry,
+                           size_t size) {
+    uint64_t position =
+        m_header->m_enqueue_position.load(std::memory_order_relaxed);
+    ShmSlot_TP* slot = nullptr;
+    while (true) {
+        slot = Slot(position);
+        uint64_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+        if (IsWriting(sequence)) {
+            if (IsWritingFor(sequence, position)) {
+                // Another producer took the position
+                position = m_header->m_enqueue_position.load(
+                    std::memory_order_relaxed);
+                continue;
+            }
+            // Full, the previous lap is still being written
+            m_header->m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        int64_t difference =
+            static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+        if (difference == 0) {
+            if (m_header->m_enqueue_position.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Full, the collector is behind or gone
+            m_header->m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position =
+                m_header->m_enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Takes ownership before touching the entry, fails only if the
+    // collector gave up on this slot meanwhile
+    uint32_t pid = CurrentPid();
+    uint64_t expected = position;
+    uint64_t writing = WritingSequence(position, pid);
+    if (!slot->m_sequence.compare_exchange_strong(expected, writing,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+        m_header->m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t room = m_slot_size - sizeof(ShmSlot_TP);
+    slot->m_pid = pid;
+    slot->m_level = static_cast<uint8_t>(level);
+    slot->m_truncated = size > room;
+    slot->m_size = static_cast<uint32_t>(size > room ? room : size);
+    std::memcpy(slot->Data(), entry, slot->m_size);
+
+    // Fails only if the collector took this process for dead, e.g. when it
+    // runs in another pid namespace
+    expected = writing;
+    if (!slot->m_sequence.compare_exchange_strong(expected, position + 1,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+        m_header->m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool ShmLogRing_C::AttachConsumer(std::chrono::milliseconds stall_timeout) {
+#ifdef SN_LOG_HAS_SHM
+    if (!m_consumer) {
+        // The lock goes away with the process, so a crashed collector never
+        // keeps its successor out
+        m_consumer = flock(m_fd, LOCK_EX | LOCK_NB) == 0;
+    }
+#endif
+    m_stall_timeout = stall_timeout;
+    return m_consumer;
+}
+
+bool ShmLogRing_C::TryPop(ShmLogEntry_TP& entry) {
+    if (!m_consumer) {
+        return false;
+    }
+    uint64_t position =
+        m_header->m_dequeue_position.load(std::memory_order_relaxed);
+    ShmSlot_TP* slot = Slot(position);
+    uint64_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+
+    if (sequence == position + 1) {
+        entry.m_pid = slot->m_pid;
+        entry.m_level = static_cast<LogSeverityLevel_TP>(slot->m_level);
+        entry.m_truncated = slot->m_truncated != 0;
+        entry.m_text.assign(slot->Data(), slot->m_size);
+        slot->m_sequence.store(position + m_capacity,
+                               std::memory_order_release);
+        m_header->m_dequeue_position.store(position + 1,
+                                           std::memory_order_relaxed);
+        return true;
+    }
+    bool writing = IsWriting(sequence);
+    if (writing ? !IsWritingFor(sequence, position)
+                : sequence >= position + m_capacity) {
+        // A previous collector freed the slot but died before moving on,
+        // producers may even have taken it again for the next lap
+        m_header->m_dequeue_position.store(position + 1,
+                                           std::memory_order_relaxed);
+        return false;
+    }
+    if (!writing && m_header->m_enqueue_position.load(
+                        std::memory_order_relaxed) <= position) {
+        // Empty
+        return false;
+    }
+
+    // Claimed or being written, give the producer some time
+    auto now = std::chrono::steady_clock::now();
+    if (m_stall_position != position) {
+        m_stall_position = position;
+        m_stall_since = now;
+        return false;
+    }
+    // An entry is only taken from a writer which is gone, a live one may
+    // still be copying it
+    if (now - m_stall_since <= m_stall_timeout ||
+        (writing && !IsProcessGone(WriterPid(sequence)))) {
+        return false;
+    }
+    uint64_t expected = sequence;
+    if (slot->m_sequence.compare_exchange_strong(
+            expected, position + m_capacity, std::memory_order_acq_rel)) {
+        m_header->m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_header->m_dequeue_position.store(position + 1,
+                                           std::memory_order_relaxed);
+    }
+    return false;
+}
+
+uint64_t ShmLogRing_C::GetDroppedCount() const {
+    return m_header->m_dropped.load(std::memory_order_relaxed);
+}
+
+}  // end namespace Log
+}  // end namespace SN
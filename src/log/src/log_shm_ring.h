@@ -0,0 +1,212 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_shm_ring.h
+ *
+ * @brief ShmLogRing_C is a lock-free ring of formatted entries in POSIX
+ * shared memory, written by any number of processes and drained by one
+ * collector.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Log includes
+#include "log_sink.h"
+#include "logging_attributes.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/** Default name of the shared memory object */
+constexpr const char* kDefaultShmLogName = "/supernova_log";
+
+struct ShmRingHeader_TP;
+struct ShmSlot_TP;
+
+/**
+ * @struct ShmLogEntry_TP
+ *
+ * @brief An entry taken out of the ring by the collector.
+ *
+ */
+struct ShmLogEntry_TP {
+    uint32_t m_pid;               //!< process which logged the entry
+    LogSeverityLevel_TP m_level;  //!< log severity level
+    bool m_truncated;             //!< entry did not fit into its slot
+    std::string m_text;           //!< formatted entry
+};
+
+/** SN::Log::ShmLogRing_C
+ *
+ * @b Description
+ * A bounded multi producer, single consumer queue of fixed size slots in a
+ * named POSIX shared memory object (Vyukov's bounded queue). Each slot
+ * carries a sequence number telling whether it is free or filled for the
+ * current lap of the ring, so producers claim a slot with one compare and
+ * swap and the collector reads it without any lock.
+ *
+ * Producers never wait: when the ring is full the entry is counted as
+ * dropped. Entries longer than a slot are truncated. The ring outlives the
+ * collector, a restarted collector continues where the previous one
+ * stopped. A producer which dies while holding a slot would block the
+ * collector, so a slot which stays claimed for longer than the stall
+ * timeout is skipped and counted as dropped. A slot already being written
+ * is skipped only once its writer process is gone.
+ *
+ * The shared memory object is created readable and writable by its owner
+ * only, so all processes sharing a ring run as the same user.
+ *
+ * The entries leave the ring in the order the producers claimed their
+ * slots, which gives one ordered stream across all processes.
+ *
+ * @b Resource @b Ownership
+ * Owns its mapping and descriptor, the shared memory object itself stays
+ * until Unlink() is called.
+ */
+class ShmLogRing_C {
+   public:
+    /**
+     * Opens the ring, creating it with the given geometry when it doesn't
+     * exist yet. An existing ring keeps its geometry.
+     *
+     * @param name name of the shared memory object, e.g. "/supernova_log"
+     * @param capacity number of slots, rounded up to a power of two
+     * @param slot_size bytes per slot including the slot header
+     * @param error description of the error
+     * @retval ring or null on error
+     */
+    static std::unique_ptr<ShmLogRing_C> Open(const std::string& name,
+                                              size_t capacity,
+                                              size_t slot_size,
+                                              std::string& error);
+
+    /**
+     * Removes the shared memory object, mappings stay valid.
+     *
+     * @param name name of the shared memory object
+     */
+    static void Unlink(const std::string& name);
+
+    ~ShmLogRing_C();
+
+    ShmLogRing_C(const ShmLogRing_C& rhs) = delete;
+    ShmLogRing_C& operator=(const ShmLogRing_C& rhs) = delete;
+
+    /**
+     * Appends an entry, never waits.
+     *
+     * @param level log severity level
+     * @param entry formatted entry
+     * @param size size of the entry
+     * @retval true if queued, false if dropped
+     */
+    bool TryPush(LogSeverityLevel_TP level, const char* entry, size_t size);
+
+    /**
+     * Makes this handle the one consumer of the ring. Fails while another
+     * process holds the ring.
+     *
+     * @param stall_timeout how long a claimed slot may stay unfilled before
+     * it is skipped
+     * @retval true if this handle is the consumer otherwise false
+     */
+    bool AttachConsumer(std::chrono::milliseconds stall_timeout =
+                            std::chrono::milliseconds(1000));
+
+    /**
+     * Takes the oldest entry, consumer only.
+     *
+     * @param entry taken entry
+     * @retval true if an entry was taken, false if there is none ready
+     */
+    bool TryPop(ShmLogEntry_TP& entry);
+
+    /**
+     * Gets the number of entries dropped since the ring was created.
+     *
+     * @retval dropped entries
+     */
+    uint64_t GetDroppedCount() const;
+
+    size_t GetCapacity() const { return m_capacity; }
+    size_t GetSlotSize() const { return m_slot_size; }
+
+   private:
+    ShmLogRing_C(int fd, void* memory, size_t mapped_size);
+
+    ShmSlot_TP* Slot(uint64_t position) const;
+
+    int m_fd;
+    void* m_memory;
+    size_t m_mapped_size;
+    ShmRingHeader_TP* m_header;
+    size_t m_capacity;
+    size_t m_slot_size;
+
+    // Consumer state
+    bool m_consumer;
+    std::chrono::milliseconds m_stall_timeout;
+    uint64_t m_stall_position;
+    std::chrono::steady_clock::time_point m_stall_since;
+};  // end ShmLogRing_C
+
+/** SN::Log::ShmLogSink_C
+ *
+ * @b Description
+ * Sink which appends the entries of this process to a shared memory ring,
+ * see Logger_C::EnableSharedMemoryLogging().
+ *
+ * @b Resource @b Ownership
+ * Owns the ring handle.
+ */
+class ShmLogSink_C : public LogSink_C {
+   public:
+    explicit ShmLogSink_C(std::unique_ptr<ShmLogRing_C> ring)
+        : m_ring(std::move(ring)) {}
+
+    void Write(const LogRecord_TP& record, const char* entry,
+               size_t size) override {
+        m_ring->TryPush(record.m_level, entry, size);
+    }
+
+   private:
+    std::unique_ptr<ShmLogRing_C> m_ring;
+};  // end ShmLogSink_C
+
+}  // end namespace Log
+}  // end namespace SN
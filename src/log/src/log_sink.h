@@ -0,0 +1,132 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_sink.h
+ *
+ * @brief LogSink_C is the interface of additional outputs of the logger.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <cstddef>
+#include <string_view>
+
+// Log includes
+#include "log_record.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct LogEntryBatch_TP
+ *
+ * @brief Formatted entries written together, back to back in one buffer.
+ *
+ */
+struct LogEntryBatch_TP {
+    /**
+     * Gets one entry.
+     *
+     * @param index entry index below m_count
+     * @retval formatted entry including the line break
+     */
+    std::string_view Entry(size_t index) const {
+        size_t begin = index == 0 ? 0 : m_ends[index - 1];
+        return std::string_view(m_data + begin, m_ends[index] - begin);
+    }
+
+    const char* m_data;                    //!< every entry back to back
+    size_t m_size;                         //!< bytes in m_data
+    const LogRecord_TP* const* m_records;  //!< record of each entry
+    const size_t* m_ends;                  //!< end of each entry in m_data
+    size_t m_count;                        //!< number of entries
+};
+
+/** SN::Log::LogSink_C
+ *
+ * @b Description
+ * An output of the logger next to the log file and the console streams.
+ * Sinks registered with Logger_C::AddSink() get every formatted entry unless
+ * the log type is NO_LOG.
+ *
+ * Write() and Flush() are called with the output lock of the logger held,
+ * from the logging thread or from the backend thread of asynchronous
+ * logging, so a sink needs no locking of its own. A sink must not log
+ * through the logger.
+ *
+ * @b Resource @b Ownership
+ * None
+ */
+class LogSink_C {
+   public:
+    virtual ~LogSink_C() = default;
+
+    /**
+     * Writes one formatted entry.
+     *
+     * @param record record the entry was formatted from
+     * @param entry formatted entry including the line break
+     * @param size size of the entry
+     */
+    virtual void Write(const LogRecord_TP& record, const char* entry,
+                       size_t size) = 0;
+
+    /**
+     * Writes a batch of formatted entries, e.g. the batch of the backend
+     * thread or of Logger_C::WriteBatch(). Calls Write() for each entry
+     * unless overridden.
+     *
+     * @param batch entries to write
+     */
+    virtual void WriteBatch(const LogEntryBatch_TP& batch) {
+        for (size_t i = 0; i < batch.m_count; ++i) {
+            std::string_view entry = batch.Entry(i);
+            Write(*batch.m_records[i], entry.data(), entry.size());
+        }
+    }
+
+    /**
+     * Flushes entries the sink buffers.
+     */
+    virtual void Flush() {}
+
+    /**
+     * Makes the entries written so far durable, e.g. by syncing a file to
+     * disk. Called by Logger_C::Sync() right after Flush(). Does nothing
+     * unless overridden.
+     *
+     * @retval true on success otherwise false
+     */
+    virtual bool Sync() { return true; }
+};  // end LogSink_C
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,203 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_site_profiler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "log_call_site.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+const char* SortKeyName(LogSiteSortKey_TP key) {
+    switch (key) {
+        case LogSiteSortKey_TP::HITS:
+            return "hits";
+        case LogSiteSortKey_TP::BYTES:
+            return "bytes";
+        case LogSiteSortKey_TP::FORMAT_TIME:
+            return "format time";
+    }
+    return "";
+}
+
+uint64_t SortValue(const LogSiteStats_TP& stats, LogSiteSortKey_TP key) {
+    switch (key) {
+        case LogSiteSortKey_TP::HITS:
+            return stats.m_hits;
+        case LogSiteSortKey_TP::BYTES:
+            return stats.m_bytes;
+        case LogSiteSortKey_TP::FORMAT_TIME:
+            return stats.m_format_ns;
+    }
+    return 0;
+}
+
+}  // namespace
+
+thread_local LogSiteProfile_TP* LogSiteProfiler_C::m_current_site = nullptr;
+
+LogSiteProfiler_C* LogSiteProfiler_C::GetInstance() {
+    // Never destroyed, sites may still log in static destructors
+    static LogSiteProfiler_C* instance = new LogSiteProfiler_C();
+    return instance;
+}
+
+LogSiteProfiler_C::LogSiteProfiler_C()
+    : m_enabled(false), m_report_top(20), m_exit_registered(false) {}
+
+void LogSiteProfiler_C::Enable(const std::string& report_file /*= ""*/,
+                               size_t top /*= 20*/) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_report_file = report_file;
+        m_report_top = top;
+        if (!m_report_file.empty() && !m_exit_registered) {
+            m_exit_registered = true;
+            std::atexit([] { LogSiteProfiler_C::GetInstance()->Disable(); });
+        }
+    }
+    m_enabled.store(true, std::memory_order_relaxed);
+    // Sites check the flag when they refresh their cached decision
+    LogCallSite_C::Invalidate();
+}
+
+void LogSiteProfiler_C::Disable() {
+    m_enabled.store(false, std::memory_order_relaxed);
+    LogCallSite_C::Invalidate();
+    std::string report_file;
+    size_t top;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        report_file.swap(m_report_file);
+        top = m_report_top;
+    }
+    if (report_file == "-") {
+        WriteReport(std::cerr, top);
+    } else if (!report_file.empty()) {
+        std::ofstream file(report_file.c_str());
+        if (!file.is_open()) {
+            std::cerr << "[ERROR] : Couldn't open file " << report_file
+                      << " for write." << std::endl;
+            return;
+        }
+        WriteReport(file, top);
+    }
+}
+
+LogSiteProfile_TP* LogSiteProfiler_C::Register(const void* site,
+                                               const char* file,
+                                               const char* function,
+                                               uint32_t line) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<LogSiteProfile_TP>& profile = m_sites[site];
+    if (!profile) {
+        profile.reset(new LogSiteProfile_TP());
+        profile->m_file = file;
+        profile->m_function = function;
+        profile->m_line = line;
+    }
+    return profile.get();
+}
+
+std::vector<LogSiteStats_TP> LogSiteProfiler_C::GetTopSites(
+    LogSiteSortKey_TP key, size_t top) const {
+    std::vector<LogSiteStats_TP> sites;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        sites.reserve(m_sites.size());
+        for (const auto& site : m_sites) {
+            const LogSiteProfile_TP& profile = *site.second;
+            sites.push_back(LogSiteStats_TP{
+                profile.m_file, profile.m_function, profile.m_line,
+                profile.m_hits.load(std::memory_order_relaxed),
+                profile.m_filtered.load(std::memory_order_relaxed),
+                profile.m_bytes.load(std::memory_order_relaxed),
+                profile.m_format_ns.load(std::memory_order_relaxed)});
+        }
+    }
+    std::sort(sites.begin(), sites.end(),
+              [key](const LogSiteStats_TP& lhs, const LogSiteStats_TP& rhs) {
+                  uint64_t left = SortValue(lhs, key);
+                  uint64_t right = SortValue(rhs, key);
+                  if (left != right) {
+                      return left > right;
+                  }
+                  // Stable order for equal counts
+                  int order = std::strcmp(lhs.m_file, rhs.m_file);
+                  return order != 0 ? order < 0 : lhs.m_line < rhs.m_line;
+              });
+    if (sites.size() > top) {
+        sites.resize(top);
+    }
+    return sites;
+}
+
+void LogSiteProfiler_C::WriteReport(std::ostream& stream,
+                                    size_t top /*= 20*/) const {
+    const LogSiteSortKey_TP keys[] = {LogSiteSortKey_TP::BYTES,
+                                      LogSiteSortKey_TP::HITS,
+                                      LogSiteSortKey_TP::FORMAT_TIME};
+    for (LogSiteSortKey_TP key : keys) {
+        stream << "Top " << top << " log sites by " << SortKeyName(key)
+               << '\n'
+               << std::setw(12) << "hits" << std::setw(12) << "filtered"
+               << std::setw(14) << "bytes" << std::setw(14) << "format us"
+               << std::setw(10) << "ns/msg" << "  site\n";
+        for (const LogSiteStats_TP& site : GetTopSites(key, top)) {
+            uint64_t logged = site.m_hits - site.m_filtered;
+            stream << std::setw(12) << site.m_hits << std::setw(12)
+                   << site.m_filtered << std::setw(14) << site.m_bytes
+                   << std::setw(14) << site.m_format_ns / 1000
+                   << std::setw(10)
+                   << (logged != 0 ? site.m_format_ns / logged : 0) << "  "
+                   << site.m_file << ':' << site.m_line << ' '
+                   << site.m_function << '\n';
+        }
+        stream << '\n';
+    }
+    stream.flush();
+}
+
+void LogSiteProfiler_C::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& site : m_sites) {
+        site.second->m_hits.store(0, std::memory_order_relaxed);
+        site.second->m_filtered.store(0, std::memory_order_relaxed);
+        site.second->m_bytes.store(0, std::memory_order_relaxed);
+        site.second->m_format_ns.store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // end namespace Log
+}  // end namespace SN
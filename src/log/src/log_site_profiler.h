@@ -0,0 +1,229 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_site_profiler.h
+ *
+ * @brief LogSiteProfiler_C counts hits, bytes and formatting time per log
+ * call site and reports the noisiest ones.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct LogSiteProfile_TP
+ *
+ * @brief Counters of one SN_LOG call site, updated with relaxed atomics.
+ *
+ */
+struct LogSiteProfile_TP {
+    const char* m_file;      //!< file name at point of log
+    const char* m_function;  //!< function name at point of log
+    uint32_t m_line;         //!< line number at point of log
+    std::atomic<uint64_t> m_hits{0};      //!< times the site was reached
+    std::atomic<uint64_t> m_filtered{0};  //!< hits not logged
+    std::atomic<uint64_t> m_bytes{0};     //!< message bytes produced
+    std::atomic<uint64_t> m_format_ns{0};  //!< time spent in the operands
+};
+
+/**
+ * @struct LogSiteStats_TP
+ *
+ * @brief Snapshot of the counters of one call site.
+ *
+ */
+struct LogSiteStats_TP {
+    const char* m_file;
+    const char* m_function;
+    uint32_t m_line;
+    uint64_t m_hits;
+    uint64_t m_filtered;
+    uint64_t m_bytes;
+    uint64_t m_format_ns;
+};
+
+/**
+ * @enum LogSiteSortKey_TP
+ *
+ * @brief Order of the profiler report.
+ *
+ */
+enum class LogSiteSortKey_TP {
+    HITS = 0,        //!< Most hits first(0)
+    BYTES = 1,       //!< Most message bytes first(1)
+    FORMAT_TIME = 2  //!< Most formatting time first(2)
+};
+
+/** SN::Log::LogSiteProfiler_C
+ *
+ * @b Description
+ * Keeps the counters of every SN_LOG call site reached while profiling. A
+ * site registers its counters the first time it is reached with profiling
+ * on, afterwards counting is a few relaxed atomic adds. The time spent
+ * evaluating the operands of a message is taken with the log clock.
+ *
+ * Sites are only counted while enabled, switching profiling on or off takes
+ * effect with the next hit of every site.
+ *
+ * @b Resource @b Ownership
+ * Owns the counters, which stay valid until the process exits.
+ */
+class LogSiteProfiler_C {
+   public:
+    /**
+     * Gets the process wide profiler, never destroyed.
+     *
+     * @retval profiler object
+     */
+    static LogSiteProfiler_C* GetInstance();
+
+    LogSiteProfiler_C(const LogSiteProfiler_C& rhs) = delete;
+    LogSiteProfiler_C& operator=(const LogSiteProfiler_C& rhs) = delete;
+
+    /**
+     * Starts counting.
+     *
+     * @param report_file file to write the report of the top sites to when
+     * profiling is stopped by Disable() or at exit, "-" for stderr, empty to
+     * only report on request
+     * @param top number of sites in that report
+     */
+    void Enable(const std::string& report_file = std::string(),
+                size_t top = 20);
+
+    /**
+     * Stops counting and writes the report file given to Enable().
+     */
+    void Disable();
+
+    /**
+     * Checks if call sites are counted.
+     *
+     * @retval true if profiling otherwise false
+     */
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Gets the counters of a call site, registering it on first use.
+     *
+     * @param site key of the site, e.g. its LogCallSite_C
+     * @param file file name at point of log, a literal
+     * @param function function name at point of log, a literal
+     * @param line line number at point of log
+     * @retval counters of the site
+     */
+    LogSiteProfile_TP* Register(const void* site, const char* file,
+                                const char* function, uint32_t line);
+
+    /**
+     * Gets the counters of the sites reached so far.
+     *
+     * @param key order of the sites
+     * @param top maximum number of sites
+     * @retval snapshot, noisiest site first
+     */
+    std::vector<LogSiteStats_TP> GetTopSites(LogSiteSortKey_TP key,
+                                             size_t top) const;
+
+    /**
+     * Writes a table of the top sites by bytes, hits and formatting time.
+     *
+     * @param stream stream to write to
+     * @param top number of sites per table
+     */
+    void WriteReport(std::ostream& stream, size_t top = 20) const;
+
+    /**
+     * Zeroes the counters of every site.
+     */
+    void Reset();
+
+    /**
+     * Hands the counters of a site which let a message through to the
+     * LogMessageShink_C constructed next on this thread.
+     *
+     * @param profile counters of the site
+     */
+    static void SetCurrentSite(LogSiteProfile_TP* profile) {
+        m_current_site = profile;
+    }
+
+    /**
+     * Takes the counters set by SetCurrentSite().
+     *
+     * @retval counters of the site or nullptr when not profiling
+     */
+    static LogSiteProfile_TP* TakeCurrentSite() {
+        LogSiteProfile_TP* profile = m_current_site;
+        if (profile != nullptr) {
+            m_current_site = nullptr;
+        }
+        return profile;
+    }
+
+    /**
+     * Drops the counters set by SetCurrentSite() when a sampler rejected
+     * the message after all, the hit counts as filtered.
+     */
+    static void RejectCurrentSite() {
+        LogSiteProfile_TP* profile = TakeCurrentSite();
+        if (profile != nullptr) {
+            profile->m_filtered.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+   private:
+    LogSiteProfiler_C();
+
+    std::atomic<bool> m_enabled;
+    mutable std::mutex m_mutex;
+    std::unordered_map<const void*, std::unique_ptr<LogSiteProfile_TP>>
+        m_sites;
+    std::string m_report_file;
+    size_t m_report_top;
+    bool m_exit_registered;
+
+    static thread_local LogSiteProfile_TP* m_current_site;
+};  // end LogSiteProfiler_C
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,453 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_socket_sink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define SN_LOG_HAS_SOCKETS 1
+#endif
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+/** Largest UDP payload sent, below the 65507 bytes IPv4 allows */
+constexpr size_t kMaxDatagram = 65000;
+/** Longest wait for a TCP connect on the sender thread */
+constexpr int kConnectTimeoutMs = 1000;
+/** How long the sender waits on a full socket before looking at the queue
+ * again */
+constexpr int kSendPollMs = 10;
+constexpr std::chrono::milliseconds kMinBackoff(50);
+constexpr std::chrono::milliseconds kMaxBackoff(5000);
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+#ifdef SN_LOG_HAS_SOCKETS
+/** Whether a non-blocking call failed because the socket is busy */
+bool WouldBlock(int error) {
+#if EAGAIN != EWOULDBLOCK
+    return error == EAGAIN || error == EWOULDBLOCK;
+#else
+    return error == EAGAIN;
+#endif
+}
+#endif
+
+}  // namespace
+
+SocketSink_C::SocketSink_C(
+    const std::string& endpoint,
+    const SocketSinkOptions_TP& options /*= SocketSinkOptions_TP()*/)
+    : m_options(options),
+      m_valid(false),
+      m_protocol(Protocol_TP::TCP),
+      m_buffered_bytes(0),
+      m_flush_requested(false),
+      m_stop(false),
+      m_socket(-1),
+      m_sending_offset(0),
+      m_connect_backoff(kMinBackoff),
+      m_connected(false),
+      m_dropped(0),
+      m_sent(0) {
+    m_valid = ParseEndpoint(endpoint);
+    if (!m_valid) {
+        std::cerr << "[ERROR] : Invalid log endpoint " << endpoint
+                  << ", expected unix:PATH, tcp:HOST:PORT or udp:HOST:PORT"
+                  << std::endl;
+        return;
+    }
+    if (m_protocol == Protocol_TP::UDP) {
+        m_options.m_batch_bytes =
+            std::min(m_options.m_batch_bytes, kMaxDatagram);
+    }
+    m_thread = std::thread(&SocketSink_C::Run, this);
+}
+
+SocketSink_C::~SocketSink_C() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    Disconnect();
+}
+
+bool SocketSink_C::ParseEndpoint(const std::string& endpoint) {
+#ifdef SN_LOG_HAS_SOCKETS
+    size_t colon = endpoint.find(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    std::string scheme = endpoint.substr(0, colon);
+    std::string address = endpoint.substr(colon + 1);
+    if (scheme == "unix") {
+        m_protocol = Protocol_TP::UNIX;
+        m_path = address;
+        return !m_path.empty() &&
+               m_path.size() < sizeof(sockaddr_un::sun_path);
+    }
+    if (scheme == "tcp") {
+        m_protocol = Protocol_TP::TCP;
+    } else if (scheme == "udp") {
+        m_protocol = Protocol_TP::UDP;
+    } else {
+        return false;
+    }
+    // The last colon separates the port, IPv6 hosts may be in brackets
+    size_t port = address.rfind(':');
+    if (port == std::string::npos || port == 0 ||
+        port + 1 == address.size()) {
+        return false;
+    }
+    m_host = address.substr(0, port);
+    m_port = address.substr(port + 1);
+    if (m_host.size() > 2 && m_host.front() == '[' && m_host.back() == ']') {
+        m_host = m_host.substr(1, m_host.size() - 2);
+    }
+    return true;
+#else
+    (void)endpoint;
+    return false;
+#endif
+}
+
+void SocketSink_C::Write(const LogRecord_TP& record, const char* entry,
+                         size_t size) {
+    if (!m_valid) {
+        return;
+    }
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        notify = Append(record, entry, size);
+    }
+    if (notify) {
+        m_wakeup.notify_one();
+    }
+}
+
+void SocketSink_C::WriteBatch(const LogEntryBatch_TP& batch) {
+    if (!m_valid) {
+        return;
+    }
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < batch.m_count; ++i) {
+            std::string_view entry = batch.Entry(i);
+            notify = Append(*batch.m_records[i], entry.data(), entry.size()) ||
+                     notify;
+        }
+    }
+    if (notify) {
+        m_wakeup.notify_one();
+    }
+}
+
+bool SocketSink_C::Append(const LogRecord_TP& record, const char* entry,
+                          size_t size) {
+    bool binary = m_options.m_framing == SocketFraming_TP::BINARY;
+    size_t header_size = binary ? sizeof(SocketFrameHeader_TP) : 0;
+    if (header_size + size > m_options.m_batch_bytes &&
+        m_protocol == Protocol_TP::UDP) {
+        // One entry has to fit into one datagram
+        size = m_options.m_batch_bytes - header_size;
+    }
+    size_t frame_size = header_size + size;
+    if (m_buffered_bytes + frame_size > m_options.m_max_buffered_bytes) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    bool was_empty = m_batches.empty();
+    if (was_empty ||
+        (!m_batches.back().m_data.empty() &&
+         m_batches.back().m_data.size() + frame_size >
+             m_options.m_batch_bytes)) {
+        m_batches.emplace_back();
+        m_batches.back().m_data.reserve(m_options.m_batch_bytes);
+        m_batches.back().m_started = std::chrono::steady_clock::now();
+    }
+    Batch_TP& batch = m_batches.back();
+    if (binary) {
+        SocketFrameHeader_TP header;
+        header.m_size =
+            htonl(static_cast<uint32_t>(frame_size - sizeof(uint32_t)));
+        header.m_version = kSocketFrameVersion;
+        header.m_level = static_cast<uint8_t>(record.m_level);
+        header.m_reserved = 0;
+        uint64_t time_ns = static_cast<uint64_t>(record.m_time.ToEpochNs());
+        // htonll is not portable, swap the halves by hand
+        uint64_t network_time =
+            (static_cast<uint64_t>(
+                 htonl(static_cast<uint32_t>(time_ns & 0xffffffffu)))
+             << 32) |
+            htonl(static_cast<uint32_t>(time_ns >> 32));
+        std::memcpy(&header.m_time_ns, &network_time, sizeof(network_time));
+        header.m_line = htonl(record.m_line);
+        batch.m_data.append(reinterpret_cast<const char*>(&header),
+                            sizeof(header));
+    }
+    batch.m_data.append(entry, size);
+    ++batch.m_entries;
+    m_buffered_bytes += frame_size;
+    // An idle sender has no deadline to wait for, so wake it for the first
+    // entry. Otherwise it sleeps until the batch is due, wake it early only
+    // when a batch is complete
+    return was_empty || m_batches.size() > 1 ||
+           batch.m_data.size() >= m_options.m_batch_bytes;
+}
+
+void SocketSink_C::Flush() {
+    if (!m_valid) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_batches.empty()) {
+            return;
+        }
+        m_flush_requested = true;
+    }
+    m_wakeup.notify_one();
+}
+
+void SocketSink_C::Run() {
+    using Clock_TP = std::chrono::steady_clock;
+    Clock_TP::time_point stop_deadline = Clock_TP::time_point::max();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        if (m_sending.m_data.empty()) {
+            // Pick the next batch once it is complete or due
+            while (!m_batches.empty() || !m_stop) {
+                if (m_batches.size() > 1 || m_stop || m_flush_requested ||
+                    (!m_batches.empty() &&
+                     (m_batches.front().m_data.size() >=
+                          m_options.m_batch_bytes ||
+                      Clock_TP::now() >= m_batches.front().m_started +
+                                             m_options.m_batch_delay))) {
+                    break;
+                }
+                if (m_batches.empty()) {
+                    m_wakeup.wait(lock);
+                } else {
+                    m_wakeup.wait_until(lock, m_batches.front().m_started +
+                                                  m_options.m_batch_delay);
+                }
+            }
+            if (m_batches.empty()) {
+                // Stopped with nothing left
+                break;
+            }
+            m_sending = std::move(m_batches.front());
+            m_batches.pop_front();
+            m_sending_offset = 0;
+            if (m_batches.empty()) {
+                m_flush_requested = false;
+            }
+        }
+        if (m_stop && stop_deadline == Clock_TP::time_point::max()) {
+            // Give the endpoint a last chance, then drop the rest
+            stop_deadline = Clock_TP::now() +
+                            std::max(m_options.m_batch_delay,
+                                     std::chrono::milliseconds(100));
+        }
+        lock.unlock();
+
+        if (!IsConnected() && Clock_TP::now() >= m_next_connect) {
+            Connect();
+        }
+        if (IsConnected() && !Send()) {
+            Disconnect();
+        }
+
+        lock.lock();
+        if (m_sending_offset >= m_sending.m_data.size()) {
+            m_buffered_bytes -= m_sending.m_data.size();
+            m_sending = Batch_TP();
+        } else if (Clock_TP::now() >= stop_deadline) {
+            size_t dropped = m_sending.m_entries;
+            m_buffered_bytes -= m_sending.m_data.size();
+            m_sending = Batch_TP();
+            for (const Batch_TP& batch : m_batches) {
+                dropped += batch.m_entries;
+                m_buffered_bytes -= batch.m_data.size();
+            }
+            m_batches.clear();
+            m_dropped.fetch_add(dropped, std::memory_order_relaxed);
+            break;
+        } else if (!IsConnected()) {
+            // Wait for the next attempt, Write() keeps buffering meanwhile
+            m_wakeup.wait_until(lock, std::min(m_next_connect, stop_deadline));
+        }
+    }
+}
+
+bool SocketSink_C::Connect() {
+#ifdef SN_LOG_HAS_SOCKETS
+    int fd = -1;
+    if (m_protocol == Protocol_TP::UNIX) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(),
+                     sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 &&
+            connect(fd, reinterpret_cast<sockaddr*>(&address),
+                    sizeof(address)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    } else {
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype =
+            m_protocol == Protocol_TP::UDP ? SOCK_DGRAM : SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(m_host.c_str(), m_port.c_str(), &hints, &addresses) ==
+            0) {
+            for (addrinfo* address = addresses; address && fd < 0;
+                 address = address->ai_next) {
+                fd = socket(address->ai_family, address->ai_socktype,
+                            address->ai_protocol);
+                if (fd < 0) {
+                    continue;
+                }
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                int result =
+                    connect(fd, address->ai_addr, address->ai_addrlen);
+                if (result != 0 && errno == EINPROGRESS) {
+                    pollfd poll_fd{fd, POLLOUT, 0};
+                    int error = ETIMEDOUT;
+                    socklen_t length = sizeof(error);
+                    if (poll(&poll_fd, 1, kConnectTimeoutMs) == 1) {
+                        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                    }
+                    result = error == 0 ? 0 : -1;
+                }
+                if (result != 0) {
+                    close(fd);
+                    fd = -1;
+                }
+            }
+            freeaddrinfo(addresses);
+        }
+    }
+    if (fd < 0) {
+        m_next_connect = std::chrono::steady_clock::now() + m_connect_backoff;
+        m_connect_backoff = std::min(m_connect_backoff * 2, kMaxBackoff);
+        return false;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    if (m_protocol == Protocol_TP::TCP) {
+        // Batching is done here already
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    m_socket = fd;
+    m_connect_backoff = kMinBackoff;
+    // A new stream starts with a whole batch
+    m_sending_offset = 0;
+    m_connected.store(true, std::memory_order_relaxed);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SocketSink_C::Disconnect() {
+#ifdef SN_LOG_HAS_SOCKETS
+    if (m_socket >= 0) {
+        close(m_socket);
+        m_socket = -1;
+    }
+#endif
+    m_connected.store(false, std::memory_order_relaxed);
+}
+
+bool SocketSink_C::Send() {
+#ifdef SN_LOG_HAS_SOCKETS
+    const std::string& data = m_sending.m_data;
+    while (m_sending_offset < data.size()) {
+        ssize_t sent = send(m_socket, data.data() + m_sending_offset,
+                            data.size() - m_sending_offset, kSendFlags);
+        if (sent > 0) {
+            m_sending_offset += static_cast<size_t>(sent);
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && WouldBlock(errno)) {
+            pollfd poll_fd{m_socket, POLLOUT, 0};
+            if (poll(&poll_fd, 1, kSendPollMs) <= 0) {
+                // Still full, let the caller look at the queue again
+                return true;
+            }
+        } else if (m_protocol == Protocol_TP::UDP) {
+            // E.g. ECONNREFUSED while no one listens, the datagram is lost
+            m_dropped.fetch_add(m_sending.m_entries,
+                                std::memory_order_relaxed);
+            m_sending_offset = data.size();
+            return true;
+        } else {
+            return false;
+        }
+    }
+    m_sent.fetch_add(m_sending.m_entries, std::memory_order_relaxed);
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,245 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_socket_sink.h
+ *
+ * @brief SocketSink_C sends batches of log entries to a collector over a Unix
+ * domain socket, UDP or TCP.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Log includes
+#include "log_sink.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @enum SocketFraming_TP
+ *
+ * @brief How entries are put on the wire.
+ *
+ */
+enum class SocketFraming_TP {
+    /** The formatted entries as they are, one per line(0) */
+    TEXT = 0,
+    /** Each entry behind a SocketFrameHeader_TP, integers in network byte
+     * order(1) */
+    BINARY = 1
+};
+
+/**
+ * @struct SocketFrameHeader_TP
+ *
+ * @brief Header of an entry with BINARY framing, followed by the formatted
+ * entry.
+ *
+ */
+#pragma pack(push, 1)
+struct SocketFrameHeader_TP {
+    uint32_t m_size;     //!< bytes following this field
+    uint8_t m_version;   //!< kSocketFrameVersion
+    uint8_t m_level;     //!< LogSeverityLevel_TP
+    uint16_t m_reserved;
+    int64_t m_time_ns;   //!< nanoseconds since the epoch
+    uint32_t m_line;     //!< line number at point of log
+};
+#pragma pack(pop)
+
+/** Version of SocketFrameHeader_TP */
+constexpr uint8_t kSocketFrameVersion = 1;
+
+/**
+ * @struct SocketSinkOptions_TP
+ *
+ * @brief Batching and buffering settings of SocketSink_C.
+ *
+ */
+struct SocketSinkOptions_TP {
+    SocketFraming_TP m_framing = SocketFraming_TP::TEXT;
+    /** A batch is sent once it holds this many bytes, UDP datagrams are
+     * capped at 65000 bytes */
+    size_t m_batch_bytes = 16384;
+    /** A batch is sent at the latest this long after its first entry */
+    std::chrono::milliseconds m_batch_delay{10};
+    /** Bytes kept while the collector is slow or unreachable, entries
+     * beyond are dropped */
+    size_t m_max_buffered_bytes = 4 << 20;
+};
+
+/** SN::Log::SocketSink_C
+ *
+ * @b Description
+ * Sends the log entries to an endpoint given as "unix:/path/to/socket",
+ * "tcp:host:port" or "udp:host:port". Unix domain sockets are stream
+ * sockets.
+ *
+ * Entries are collected into batches, which go out when they are full,
+ * when the batch delay has passed, or when the logger flushes. Connecting,
+ * sending and reconnecting happen on a thread of the sink with a
+ * non-blocking socket, so logging never waits for the network. While the
+ * endpoint is unreachable or slow the batches are kept up to the buffer
+ * limit, further entries are dropped and counted.
+ *
+ * A batch holds whole entries only, so each UDP datagram can be parsed on
+ * its own.
+ *
+ * @b Resource @b Ownership
+ * Owns the socket and the sender thread.
+ */
+class SocketSink_C : public LogSink_C {
+   public:
+    /**
+     * Starts the sender thread, which connects in the background.
+     *
+     * @param endpoint endpoint to send to
+     * @param options batching and buffering settings
+     */
+    explicit SocketSink_C(const std::string& endpoint,
+                          const SocketSinkOptions_TP& options =
+                              SocketSinkOptions_TP());
+
+    /**
+     * Sends what is buffered, waiting up to one batch delay for the
+     * endpoint, and stops the sender thread.
+     */
+    ~SocketSink_C() override;
+
+    SocketSink_C(const SocketSink_C& rhs) = delete;
+    SocketSink_C& operator=(const SocketSink_C& rhs) = delete;
+
+    void Write(const LogRecord_TP& record, const char* entry,
+               size_t size) override;
+
+    /**
+     * Appends the whole batch under one lock.
+     */
+    void WriteBatch(const LogEntryBatch_TP& batch) override;
+
+    /**
+     * Asks the sender thread to send the current batch now, doesn't wait.
+     */
+    void Flush() override;
+
+    /**
+     * Checks if the endpoint could be parsed.
+     *
+     * @retval true if the sink can send otherwise false
+     */
+    bool IsValid() const { return m_valid; }
+
+    /**
+     * Checks if the socket is connected.
+     *
+     * @retval true if connected otherwise false
+     */
+    bool IsConnected() const {
+        return m_connected.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the number of entries dropped for lack of buffer or by the
+     * network.
+     *
+     * @retval dropped entries
+     */
+    uint64_t GetDroppedCount() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the number of entries handed to the socket.
+     *
+     * @retval sent entries
+     */
+    uint64_t GetSentCount() const {
+        return m_sent.load(std::memory_order_relaxed);
+    }
+
+   private:
+    /** Entries sent together, one datagram with UDP */
+    struct Batch_TP {
+        std::string m_data;
+        size_t m_entries = 0;
+        std::chrono::steady_clock::time_point m_started;
+    };
+
+    enum class Protocol_TP { UNIX, TCP, UDP };
+
+    bool ParseEndpoint(const std::string& endpoint);
+    /** Appends an entry to the batches, m_mutex must be held. Returns true
+     * when a batch is complete */
+    bool Append(const LogRecord_TP& record, const char* entry, size_t size);
+    void Run();
+    bool Connect();
+    void Disconnect();
+    /** Sends from m_sending, returns false on a connection error */
+    bool Send();
+
+    SocketSinkOptions_TP m_options;
+    bool m_valid;
+    Protocol_TP m_protocol;
+    std::string m_path;  //!< Unix domain socket path
+    std::string m_host;
+    std::string m_port;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::deque<Batch_TP> m_batches;  //!< filled by Write()
+    size_t m_buffered_bytes;         //!< in m_batches and m_sending
+    bool m_flush_requested;
+    bool m_stop;
+
+    // Sender thread only
+    int m_socket;
+    Batch_TP m_sending;
+    size_t m_sending_offset;
+    std::chrono::steady_clock::time_point m_next_connect;
+    std::chrono::milliseconds m_connect_backoff;
+
+    std::atomic<bool> m_connected;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_sent;
+    std::thread m_thread;
+};  // end SocketSink_C
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,469 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <thread>
+
+#include "log_format_kernels.h"
+#include "log_mapped_file.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+/** Smallest chunk worth a task of its own */
+constexpr size_t kMinChunkBytes = 1 << 20;
+
+constexpr size_t kLevelCount = std::tuple_size<LogLevelCounts_TP>::value;
+
+void AddCounts(LogLevelCounts_TP& counts, const LogLevelCounts_TP& other) {
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        counts[i] += other[i];
+    }
+}
+
+uint64_t Total(const LogLevelCounts_TP& counts) {
+    uint64_t total = 0;
+    for (uint64_t count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+/** Gets the level written by ToString(), -1 for any other text */
+int LevelIndex(std::string_view name) {
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        if (name == ToString(static_cast<LogSeverityLevel_TP>(i))) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/** Parses unsigned decimal digits at pos, at least one */
+bool ParseDigits(const char*& pos, const char* end, int64_t& value) {
+    const char* begin = pos;
+    value = 0;
+    while (pos != end && *pos >= '0' && *pos <= '9') {
+        value = value * 10 + (*pos - '0');
+        ++pos;
+    }
+    return pos != begin;
+}
+
+/** Days since 1970-01-01 of a date of the proleptic Gregorian calendar */
+int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year =
+        (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 -
+                         year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+/** Parses the "Www Mmm dd hh:mm:ss yyyy" form of ctime() */
+bool ParseDateTime(std::string_view field, int64_t& seconds) {
+    static constexpr char kMonths[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    const char* pos = field.data();
+    const char* end = pos + field.size();
+    pos = Kernels::FindByte(pos, end, ' ');
+    if (end - pos < 5) {
+        return false;
+    }
+    ++pos;
+    int64_t month = 0;
+    while (month < 12 && std::memcmp(kMonths + 3 * month, pos, 3) != 0) {
+        ++month;
+    }
+    if (month == 12) {
+        return false;
+    }
+    pos += 3;
+    while (pos != end && *pos == ' ') {
+        ++pos;
+    }
+    int64_t day = 0;
+    int64_t hour = 0;
+    int64_t minute = 0;
+    int64_t second = 0;
+    int64_t year = 0;
+    if (!ParseDigits(pos, end, day) || pos == end || *pos++ != ' ' ||
+        !ParseDigits(pos, end, hour) || pos == end || *pos++ != ':' ||
+        !ParseDigits(pos, end, minute) || pos == end || *pos++ != ':' ||
+        !ParseDigits(pos, end, second) || pos == end || *pos++ != ' ' ||
+        !ParseDigits(pos, end, year) || pos != end) {
+        return false;
+    }
+    seconds = DaysFromCivil(year, month + 1, day) * 86400 + hour * 3600 +
+              minute * 60 + second;
+    return true;
+}
+
+/** Rounds down to a multiple of width, also for negative values */
+int64_t FloorTo(int64_t value, int64_t width) {
+    int64_t quotient = value / width;
+    if (value % width != 0 && value < 0) {
+        --quotient;
+    }
+    return quotient * width;
+}
+
+void WriteBucketTime(std::ostream& stream, int64_t seconds) {
+    time_t time = seconds;
+    struct tm parts;
+#ifdef WIN32
+    gmtime_s(&parts, &time);
+#else
+    gmtime_r(&time, &parts);
+#endif
+    char text[32];
+    size_t length = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S",
+                                  &parts);
+    stream << std::setw(20) << std::string(text, length);
+}
+
+void WriteLevelHeader(std::ostream& stream) {
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        stream << std::setw(10) << static_cast<LogSeverityLevel_TP>(i);
+    }
+}
+
+void WriteLevelCounts(std::ostream& stream, const LogLevelCounts_TP& counts) {
+    for (uint64_t count : counts) {
+        stream << std::setw(10) << count;
+    }
+}
+
+}  // namespace
+
+void LogStats_TP::Merge(const LogStats_TP& other) {
+    m_lines += other.m_lines;
+    m_unparsed += other.m_unparsed;
+    AddCounts(m_levels, other.m_levels);
+    for (const auto& site : other.m_sites) {
+        AddCounts(m_sites[site.first], site.second);
+    }
+    for (const auto& bucket : other.m_buckets) {
+        AddCounts(m_buckets[bucket.first], bucket.second);
+    }
+}
+
+LogStatsParser_C::LogStatsParser_C(const std::string& format,
+                                   TimeStampMode_TP time_stamp_mode,
+                                   int64_t bucket_seconds)
+    : m_format(format),
+      m_time_stamp_mode(time_stamp_mode),
+      m_bucket_seconds(bucket_seconds > 0 ? bucket_seconds : 0) {}
+
+void LogStatsParser_C::ParseChunk(std::string_view data,
+                                  LogStats_TP& stats) const {
+    std::string key;
+    const char* pos = data.data();
+    const char* end = pos + data.size();
+    while (pos != end) {
+        const char* line_end = Kernels::FindByte(pos, end, '\n');
+        const char* text_end = line_end;
+        if (text_end != pos && text_end[-1] == '\r') {
+            --text_end;
+        }
+        ++stats.m_lines;
+        if (!ParseLine(std::string_view(
+                           pos, static_cast<size_t>(text_end - pos)),
+                       stats, key)) {
+            ++stats.m_unparsed;
+        }
+        pos = line_end == end ? end : line_end + 1;
+    }
+}
+
+bool LogStatsParser_C::ParseLine(std::string_view line, LogStats_TP& stats,
+                                 std::string& key) const {
+    const std::vector<FormatOp_TP>& ops = m_format.GetOps();
+    const char* pos = line.data();
+    const char* end = pos + line.size();
+    std::string_view time;
+    std::string_view file;
+    std::string_view line_number;
+    std::string_view function;
+    bool has_time = false;
+    bool has_site = false;
+    // Formats without a level count every entry as INFO
+    int level = static_cast<int>(LogSeverityLevel_TP::LOG_INFO);
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const FormatOp_TP& op = ops[i];
+        if (op.m_kind == FormatOpKind_TP::LITERAL) {
+            size_t size = op.m_literal.size();
+            if (static_cast<size_t>(end - pos) < size ||
+                std::memcmp(pos, op.m_literal.data(), size) != 0) {
+                return false;
+            }
+            pos += size;
+            continue;
+        }
+        // A field ends where the next literal starts, two fields without a
+        // literal in between are taken as separated by a space
+        const char* field_end = end;
+        if (i + 1 < ops.size()) {
+            const FormatOp_TP& next = ops[i + 1];
+            field_end =
+                next.m_kind == FormatOpKind_TP::LITERAL
+                    ? Kernels::FindText(pos, end, next.m_literal.data(),
+                                        next.m_literal.size())
+                    : Kernels::FindByte(pos, end, ' ');
+        }
+        std::string_view field(pos, static_cast<size_t>(field_end - pos));
+        switch (op.m_kind) {
+            case FormatOpKind_TP::TIME_STAMP:
+                time = field;
+                has_time = true;
+                break;
+            case FormatOpKind_TP::FILE:
+                file = field;
+                has_site = true;
+                break;
+            case FormatOpKind_TP::LINE:
+                line_number = field;
+                has_site = true;
+                break;
+            case FormatOpKind_TP::FUNCTION:
+                function = field;
+                has_site = true;
+                break;
+            case FormatOpKind_TP::LEVEL:
+                level = LevelIndex(field);
+                if (level < 0) {
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+        pos = field_end;
+    }
+    if (pos != end) {
+        return false;
+    }
+
+    ++stats.m_levels[static_cast<size_t>(level)];
+    if (has_site) {
+        key.assign(file.data(), file.size());
+        key += ':';
+        key.append(line_number.data(), line_number.size());
+        key += ' ';
+        key.append(function.data(), function.size());
+        auto site = stats.m_sites.find(key);
+        if (site == stats.m_sites.end()) {
+            site = stats.m_sites.emplace(key, LogLevelCounts_TP{}).first;
+        }
+        ++site->second[static_cast<size_t>(level)];
+    }
+    int64_t seconds = 0;
+    if (m_bucket_seconds != 0 && has_time && ParseTime(time, seconds)) {
+        ++stats.m_buckets[FloorTo(seconds, m_bucket_seconds)]
+                         [static_cast<size_t>(level)];
+    }
+    return true;
+}
+
+bool LogStatsParser_C::ParseTime(std::string_view field,
+                                 int64_t& seconds) const {
+    int64_t divisor = 1;
+    switch (m_time_stamp_mode) {
+        case TimeStampMode_TP::DATE_TIME:
+            return ParseDateTime(field, seconds);
+        case TimeStampMode_TP::EPOCH_SECONDS:
+            break;
+        case TimeStampMode_TP::EPOCH_MILLI_SECONDS:
+            divisor = 1000;
+            break;
+        case TimeStampMode_TP::EPOCH_MICRO_SECONDS:
+            divisor = 1000000;
+            break;
+        default:
+            return false;
+    }
+    const char* pos = field.data();
+    const char* end = pos + field.size();
+    bool negative = pos != end && *pos == '-';
+    if (negative) {
+        ++pos;
+    }
+    int64_t value = 0;
+    if (!ParseDigits(pos, end, value) || pos != end) {
+        return false;
+    }
+    seconds = FloorTo(negative ? -value : value, divisor) / divisor;
+    return true;
+}
+
+std::vector<std::string_view> SplitLogChunks(std::string_view data,
+                                             size_t chunks) {
+    std::vector<std::string_view> result;
+    if (chunks == 0) {
+        chunks = 1;
+    }
+    size_t target = (data.size() + chunks - 1) / chunks;
+    const char* end = data.data() + data.size();
+    size_t begin = 0;
+    while (begin < data.size()) {
+        size_t cut = begin + target;
+        if (cut >= data.size()) {
+            cut = data.size();
+        } else {
+            // Include the line break the cut falls on or the next one
+            const char* line_end =
+                Kernels::FindByte(data.data() + cut - 1, end, '\n');
+            cut = line_end == end
+                      ? data.size()
+                      : static_cast<size_t>(line_end - data.data()) + 1;
+        }
+        result.push_back(data.substr(begin, cut - begin));
+        begin = cut;
+    }
+    return result;
+}
+
+bool CollectLogStats(const std::vector<std::string>& file_names,
+                     const LogStatsParser_C& parser, unsigned threads,
+                     LogStats_TP& stats, std::string& error) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    bool ok = true;
+    std::vector<std::unique_ptr<LogMappedFile_C>> files;
+    std::vector<std::string_view> chunks;
+    for (const std::string& file_name : file_names) {
+        files.emplace_back(new LogMappedFile_C());
+        if (!files.back()->Open(file_name, error)) {
+            ok = false;
+            continue;
+        }
+        std::string_view data = files.back()->View();
+        // A few chunks per thread even out files and chunks of different
+        // cost
+        size_t pieces = std::min<size_t>(
+            std::max<size_t>(data.size() / kMinChunkBytes, 1), threads * 4);
+        std::vector<std::string_view> file_chunks =
+            SplitLogChunks(data, pieces);
+        chunks.insert(chunks.end(), file_chunks.begin(), file_chunks.end());
+    }
+
+    size_t workers = std::max<size_t>(std::min<size_t>(threads, chunks.size()),
+                                      1);
+    std::vector<LogStats_TP> partial(workers);
+    std::atomic<size_t> next(0);
+    auto work = [&chunks, &parser, &partial, &next](size_t worker) {
+        for (size_t chunk = next.fetch_add(1); chunk < chunks.size();
+             chunk = next.fetch_add(1)) {
+            parser.ParseChunk(chunks[chunk], partial[worker]);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (size_t worker = 1; worker < workers; ++worker) {
+        pool.emplace_back(work, worker);
+    }
+    work(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    for (const LogStats_TP& part : partial) {
+        stats.Merge(part);
+    }
+    return ok;
+}
+
+void WriteLogStats(const LogStats_TP& stats, std::ostream& stream,
+                   LogSeverityLevel_TP rank_level, size_t top) {
+    stream << Total(stats.m_levels) << " entries in " << stats.m_lines
+           << " lines, " << stats.m_unparsed
+           << " lines don't match the format\n\nEntries per level\n";
+    for (size_t i = 0; i < kLevelCount; ++i) {
+        stream << std::setw(10) << static_cast<LogSeverityLevel_TP>(i)
+               << std::setw(14) << stats.m_levels[i] << '\n';
+    }
+
+    size_t rank_begin = static_cast<size_t>(rank_level);
+    auto ranked = [rank_begin](const LogLevelCounts_TP& counts) {
+        uint64_t count = 0;
+        for (size_t i = rank_begin; i < kLevelCount; ++i) {
+            count += counts[i];
+        }
+        return count;
+    };
+    using Site_TP =
+        std::unordered_map<std::string, LogLevelCounts_TP>::const_iterator;
+    std::vector<Site_TP> sites;
+    for (auto site = stats.m_sites.begin(); site != stats.m_sites.end();
+         ++site) {
+        if (ranked(site->second) != 0) {
+            sites.push_back(site);
+        }
+    }
+    std::sort(sites.begin(), sites.end(),
+              [&ranked](const Site_TP& lhs, const Site_TP& rhs) {
+                  uint64_t left = ranked(lhs->second);
+                  uint64_t right = ranked(rhs->second);
+                  if (left != right) {
+                      return left > right;
+                  }
+                  // Stable order for equal counts
+                  return lhs->first < rhs->first;
+              });
+    if (sites.size() > top) {
+        sites.resize(top);
+    }
+    stream << "\nTop " << top << " log sites by entries at " << rank_level
+           << " or higher\n";
+    WriteLevelHeader(stream);
+    stream << "  site\n";
+    for (const Site_TP& site : sites) {
+        WriteLevelCounts(stream, site->second);
+        stream << "  " << site->first << '\n';
+    }
+
+    if (!stats.m_buckets.empty()) {
+        stream << "\nEntries per time bucket\n" << std::setw(20) << "start";
+        WriteLevelHeader(stream);
+        stream << '\n';
+        for (const auto& bucket : stats.m_buckets) {
+            WriteBucketTime(stream, bucket.first);
+            WriteLevelCounts(stream, bucket.second);
+            stream << '\n';
+        }
+    }
+}
+
+}  // end namespace Log
+}  // end namespace SN
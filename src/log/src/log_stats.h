@@ -0,0 +1,181 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+
+/**
+ * @file log_stats.h
+ *
+ * @brief Counts the entries of written log files per level, per log site
+ * and per time bucket.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <array>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Log includes
+#include "log_format.h"
+#include "logging_attributes.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/** Entries per level, indexed by LogSeverityLevel_TP */
+using LogLevelCounts_TP = std::array<uint64_t, 6>;
+
+/**
+ * @struct LogStats_TP
+ *
+ * @brief Entry counts of one or more log files.
+ *
+ */
+struct LogStats_TP {
+    /**
+     * Adds the counts of another part of the logs.
+     *
+     * @param other counts to add
+     */
+    void Merge(const LogStats_TP& other);
+
+    uint64_t m_lines = 0;  //!< lines scanned
+    /** Lines not matching the format, e.g. the continuation lines of
+     * messages spanning several lines */
+    uint64_t m_unparsed = 0;
+    LogLevelCounts_TP m_levels{};  //!< entries per level
+    /** Entries per site, keyed by "file:line function" as far as the format
+     * has these fields */
+    std::unordered_map<std::string, LogLevelCounts_TP> m_sites;
+    /** Entries per time bucket, keyed by the start of the bucket in seconds
+     * since the epoch */
+    std::map<int64_t, LogLevelCounts_TP> m_buckets;
+};
+
+/** SN::Log::LogStatsParser_C
+ *
+ * @b Description
+ * Parses written log entries back into their fields, driven by the same
+ * format string Logger_C::SetFormat() takes. A field ends where the literal
+ * text following it in the format starts, the last field at the end of the
+ * line. Lines are located with the SIMD scan of Kernels::FindByte().
+ *
+ * Time stamps are read in the given mode. DATE_TIME stamps are local time
+ * without a zone, their buckets are keyed as if the wall clock were UTC.
+ *
+ * @note
+ * The parser is immutable and is safe to share between threads.
+ */
+class LogStatsParser_C {
+   public:
+    /**
+     * Compiles the format.
+     *
+     * @param format format string the logs were written with
+     * @param time_stamp_mode mode the time stamps were written in
+     * @param bucket_seconds width of a time bucket, 0 for no buckets
+     */
+    LogStatsParser_C(const std::string& format,
+                     TimeStampMode_TP time_stamp_mode,
+                     int64_t bucket_seconds);
+
+    /**
+     * Counts the entries of whole lines.
+     *
+     * @param data lines, a last line without a line break counts as well
+     * @param stats counts to add to
+     */
+    void ParseChunk(std::string_view data, LogStats_TP& stats) const;
+
+    /**
+     * Counts a single line.
+     *
+     * @param line line without its line break
+     * @param stats counts to add to
+     * @param key scratch buffer for the site key, reused between lines
+     * @retval true if the line matches the format otherwise false
+     */
+    bool ParseLine(std::string_view line, LogStats_TP& stats,
+                   std::string& key) const;
+
+   private:
+    /** Parses a time stamp into seconds since the epoch */
+    bool ParseTime(std::string_view field, int64_t& seconds) const;
+
+    LogFormat_C m_format;
+    TimeStampMode_TP m_time_stamp_mode;
+    int64_t m_bucket_seconds;
+};  // end LogStatsParser_C
+
+/**
+ * Splits data into about equal chunks which end at line breaks.
+ *
+ * @param data data to split
+ * @param chunks number of chunks wanted
+ * @retval chunks in order, fewer when the lines are long
+ */
+std::vector<std::string_view> SplitLogChunks(std::string_view data,
+                                             size_t chunks);
+
+/**
+ * Counts the entries of log files. Every file is memory mapped, split into
+ * chunks at line breaks and the chunks are parsed by a pool of threads.
+ *
+ * @param file_names files to read
+ * @param parser parser of the format the files were written with
+ * @param threads number of threads, 0 for one per core
+ * @param stats counts of all files
+ * @param error description of the files which could not be read
+ * @retval true if every file was read otherwise false
+ */
+bool CollectLogStats(const std::vector<std::string>& file_names,
+                     const LogStatsParser_C& parser, unsigned threads,
+                     LogStats_TP& stats, std::string& error);
+
+/**
+ * Writes the counts as text tables, the levels, the top sites and the time
+ * buckets.
+ *
+ * @param stats counts to write
+ * @param stream output stream
+ * @param rank_level sites are ranked by their entries at this level or
+ * higher
+ * @param top number of sites to write
+ */
+void WriteLogStats(const LogStats_TP& stats, std::ostream& stream,
+                   LogSeverityLevel_TP rank_level, size_t top);
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,375 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_stream.h
+ *
+ * @brief LogStream_C is the stream the log macros hand out, it formats common
+ * operands straight into the message buffer.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <cstdint>
+#include <ios>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Log includes
+#include "log_buffer.h"
+#include "log_format_kernels.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct HexValue_TP
+ *
+ * @brief Operand written in hexadecimal with a "0x" prefix, see Hex().
+ *
+ */
+struct HexValue_TP {
+    uint64_t m_value;
+};
+
+/**
+ * @struct FixedValue_TP
+ *
+ * @brief Operand written with a fixed number of decimals, see Fixed().
+ *
+ */
+struct FixedValue_TP {
+    double m_value;
+    int m_precision;
+};
+
+/**
+ * @enum BytesEncoding_TP
+ *
+ * @brief Text encodings of binary data in a message.
+ *
+ */
+enum class BytesEncoding_TP {
+    HEX = 0,    //!< Two lower case hex digits per byte(0)
+    BASE64 = 1  //!< Standard base64 with padding(1)
+};
+
+/**
+ * @struct BytesValue_TP
+ *
+ * @brief Binary operand encoded as text, see HexBytes() and Base64Bytes().
+ *
+ */
+struct BytesValue_TP {
+    const uint8_t* m_data;
+    size_t m_size;
+    /** Bytes encoded at most, the rest is only counted */
+    size_t m_limit;
+    BytesEncoding_TP m_encoding;
+};
+
+/**
+ * Logs a value in hexadecimal, e.g. SN_LOG_INFO << Log::Hex(flags).
+ *
+ * @param value value to log
+ * @retval stream operand
+ */
+inline HexValue_TP Hex(uint64_t value) { return HexValue_TP{value}; }
+
+/**
+ * Logs a value with a fixed number of decimals, e.g.
+ * SN_LOG_INFO << Log::Fixed(ratio, 3).
+ *
+ * @param value value to log
+ * @param precision number of decimals
+ * @retval stream operand
+ */
+inline FixedValue_TP Fixed(double value, int precision) {
+    return FixedValue_TP{value, precision};
+}
+
+/**
+ * Logs binary data in hexadecimal, e.g. a CAN frame with
+ * SN_LOG_DEBUG << Log::HexBytes(frame.data, frame.len). The bytes are
+ * encoded straight into the message buffer, see also SN_LOG_HEX.
+ *
+ * @param data bytes to log, read while the message is built
+ * @param size number of bytes
+ * @param limit bytes encoded at most, the rest is noted as "...(+N bytes)"
+ * @retval stream operand
+ */
+inline BytesValue_TP HexBytes(const void* data, size_t size,
+                              size_t limit = SIZE_MAX) {
+    return BytesValue_TP{static_cast<const uint8_t*>(data), size, limit,
+                         BytesEncoding_TP::HEX};
+}
+
+/**
+ * Logs binary data in base64, see HexBytes().
+ *
+ * @param data bytes to log, read while the message is built
+ * @param size number of bytes
+ * @param limit bytes encoded at most, the rest is noted as "...(+N bytes)"
+ * @retval stream operand
+ */
+inline BytesValue_TP Base64Bytes(const void* data, size_t size,
+                                 size_t limit = SIZE_MAX) {
+    return BytesValue_TP{static_cast<const uint8_t*>(data), size, limit,
+                         BytesEncoding_TP::BASE64};
+}
+
+/** SN::Log::LogStream_C
+ *
+ * @b Description
+ * Stream of a log message. Integers, floating point numbers, pointers,
+ * characters and strings are written straight into the LogBuffer_C by the
+ * formatting kernels. Every other operand, e.g. a type with its own
+ * operator<<, goes through an std::ostream over the same buffer, so the two
+ * paths interleave in order.
+ *
+ * Manipulators are forwarded to the std::ostream. Once an operand needs its
+ * flags, e.g. after std::hex or std::setw, numbers take the std::ostream path
+ * as well. The one intended difference is the default double, which is
+ * written as the shortest text reading back to the same value instead of
+ * with six significant digits.
+ *
+ * The std::ostream is only constructed once an operand or a manipulator
+ * needs it, constructing one copies the global locale.
+ *
+ * @b Rationale
+ * The iostream number formatting consults the locale and the stream state for
+ * every operand, which dominates the cost of a typical message.
+ *
+ * @b Resource @b Ownership
+ * None, the buffer is owned by the caller.
+ */
+class LogStream_C {
+   public:
+    explicit LogStream_C(LogBuffer_C& buffer) : m_buffer(buffer) {}
+
+    LogStream_C(const LogStream_C& rhs) = delete;
+    LogStream_C& operator=(const LogStream_C& rhs) = delete;
+
+    LogStream_C& operator<<(short value) { return Integer(value); }
+    LogStream_C& operator<<(int value) { return Integer(value); }
+    LogStream_C& operator<<(long value) { return Integer(value); }
+    LogStream_C& operator<<(long long value) { return Integer(value); }
+    LogStream_C& operator<<(unsigned short value) { return Integer(value); }
+    LogStream_C& operator<<(unsigned int value) { return Integer(value); }
+    LogStream_C& operator<<(unsigned long value) { return Integer(value); }
+    LogStream_C& operator<<(unsigned long long value) {
+        return Integer(value);
+    }
+
+    LogStream_C& operator<<(float value) {
+        return *this << static_cast<double>(value);
+    }
+
+    LogStream_C& operator<<(double value) {
+        if (IsPlain()) {
+            m_buffer.Commit(Kernels::FormatDouble(
+                value, m_buffer.Reserve(Kernels::kMaxDoubleChars)));
+        } else if (!HasWidth() &&
+                   (m_ostream->m_stream.flags() & kFormatFlags) ==
+                       (std::ios_base::dec | std::ios_base::fixed)) {
+            *this << Fixed(value,
+                           static_cast<int>(m_ostream->m_stream.precision()));
+        } else {
+            m_ostream->m_stream << value;
+        }
+        return *this;
+    }
+
+    LogStream_C& operator<<(char value) {
+        if (!HasWidth()) {
+            m_buffer.Append(value);
+        } else {
+            m_ostream->m_stream << value;
+        }
+        return *this;
+    }
+
+    LogStream_C& operator<<(const char* value) {
+        if (HasWidth()) {
+            m_ostream->m_stream << (value ? value : "(null)");
+        } else {
+            m_buffer.Append(value ? std::string_view(value) : "(null)");
+        }
+        return *this;
+    }
+
+    LogStream_C& operator<<(char* value) {
+        return *this << static_cast<const char*>(value);
+    }
+
+    LogStream_C& operator<<(std::string_view value) {
+        if (!HasWidth()) {
+            m_buffer.Append(value);
+        } else {
+            m_ostream->m_stream << value;
+        }
+        return *this;
+    }
+
+    LogStream_C& operator<<(const std::string& value) {
+        return *this << std::string_view(value);
+    }
+
+    LogStream_C& operator<<(const void* value) {
+        if (!HasWidth()) {
+            m_buffer.Commit(Kernels::FormatPointer(
+                value, m_buffer.Reserve(Kernels::kMaxHexChars)));
+        } else {
+            m_ostream->m_stream << value;
+        }
+        return *this;
+    }
+
+    LogStream_C& operator<<(HexValue_TP value) {
+        char* out = m_buffer.Reserve(Kernels::kMaxHexChars);
+        out[0] = '0';
+        out[1] = 'x';
+        m_buffer.Commit(2 + Kernels::FormatHex(value.m_value, out + 2));
+        return *this;
+    }
+
+    LogStream_C& operator<<(FixedValue_TP value) {
+        m_buffer.Commit(Kernels::FormatFixed(
+            value.m_value, value.m_precision,
+            m_buffer.Reserve(Kernels::kMaxFixedChars)));
+        return *this;
+    }
+
+    LogStream_C& operator<<(BytesValue_TP value) {
+        size_t size = value.m_size < value.m_limit ? value.m_size
+                                                   : value.m_limit;
+        if (value.m_encoding == BytesEncoding_TP::HEX) {
+            m_buffer.Commit(Kernels::EncodeHex(
+                value.m_data, size, m_buffer.Reserve(Kernels::HexSize(size))));
+        } else {
+            m_buffer.Commit(Kernels::EncodeBase64(
+                value.m_data, size,
+                m_buffer.Reserve(Kernels::Base64Size(size))));
+        }
+        if (size < value.m_size) {
+            m_buffer.Append("...(+", 5);
+            m_buffer.Commit(Kernels::FormatUnsigned(
+                value.m_size - size,
+                m_buffer.Reserve(Kernels::kMaxIntegerChars)));
+            m_buffer.Append(" bytes)", 7);
+        }
+        return *this;
+    }
+
+    /** Manipulators such as std::endl */
+    LogStream_C& operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+        manipulator(GetOStream());
+        return *this;
+    }
+
+    /** Manipulators such as std::hex */
+    LogStream_C& operator<<(std::ios_base& (*manipulator)(std::ios_base&)) {
+        manipulator(GetOStream());
+        return *this;
+    }
+
+    /** Any other operand, formatted by its std::ostream operator<< */
+    template <typename Value_TP>
+    LogStream_C& operator<<(const Value_TP& value) {
+        GetOStream() << value;
+        return *this;
+    }
+
+    /**
+     * Gets the std::ostream over the message buffer.
+     *
+     * @retval underlying stream
+     */
+    std::ostream& GetOStream() {
+        if (!m_ostream) {
+            m_ostream.emplace(m_buffer);
+        }
+        return m_ostream->m_stream;
+    }
+
+   private:
+    /** Flags which change how numbers are written */
+    static constexpr std::ios_base::fmtflags kFormatFlags =
+        std::ios_base::basefield | std::ios_base::floatfield |
+        std::ios_base::showpos | std::ios_base::showbase |
+        std::ios_base::showpoint | std::ios_base::uppercase |
+        std::ios_base::boolalpha;
+
+    /** std::ostream of the message, constructed on first use */
+    struct OStream_TP {
+        explicit OStream_TP(LogBuffer_C& buffer)
+            : m_stream_buffer(buffer), m_stream(&m_stream_buffer) {}
+
+        LogStreamBuf_C m_stream_buffer;  //!< appends to the message buffer
+        std::ostream m_stream;
+    };
+
+    bool IsPlain() const {
+        return !m_ostream ||
+               (m_ostream->m_stream.width() == 0 &&
+                (m_ostream->m_stream.flags() & kFormatFlags) ==
+                    std::ios_base::dec);
+    }
+
+    bool HasWidth() const {
+        return m_ostream && m_ostream->m_stream.width() != 0;
+    }
+
+    template <typename Integer_TP>
+    LogStream_C& Integer(Integer_TP value) {
+        if (!IsPlain()) {
+            m_ostream->m_stream << value;
+        } else if (std::is_signed<Integer_TP>::value) {
+            m_buffer.Commit(Kernels::FormatSigned(
+                static_cast<int64_t>(value),
+                m_buffer.Reserve(Kernels::kMaxIntegerChars)));
+        } else {
+            m_buffer.Commit(Kernels::FormatUnsigned(
+                static_cast<uint64_t>(value),
+                m_buffer.Reserve(Kernels::kMaxIntegerChars)));
+        }
+        return *this;
+    }
+
+    LogBuffer_C& m_buffer;
+    /** Formats the operands the kernels don't handle */
+    std::optional<OStream_TP> m_ostream;
+};  // end LogStream_C
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,246 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_thread_file.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <queue>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "log_format_kernels.h"
+#include "log_mapped_file.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+/** Buffered bytes at which the entries go to the file */
+constexpr size_t kThreadFileBufferBytes = 65536;
+
+/** Longest stamp, three numbers and their separators */
+constexpr size_t kMaxStampChars = 3 * (Kernels::kMaxIntegerChars + 1);
+
+/** Parses a decimal number followed by a space */
+bool ParseNumber(std::string_view data, size_t& offset, uint64_t& value) {
+    size_t begin = offset;
+    value = 0;
+    while (offset < data.size() && data[offset] >= '0' &&
+           data[offset] <= '9') {
+        value = value * 10 + static_cast<uint64_t>(data[offset] - '0');
+        ++offset;
+    }
+    if (offset == begin || offset >= data.size() || data[offset] != ' ') {
+        return false;
+    }
+    ++offset;
+    return true;
+}
+
+/** Position of the merge in one file */
+struct MergeCursor_TP {
+    std::string_view m_data;
+    size_t m_offset;
+    size_t m_file_index;
+    LogThreadFileRecord_TP m_record;
+};
+
+/** Orders the heap so that the earliest entry is on top */
+struct LaterEntry_TP {
+    bool operator()(const MergeCursor_TP* lhs,
+                    const MergeCursor_TP* rhs) const {
+        if (lhs->m_record.m_time_ns != rhs->m_record.m_time_ns) {
+            return lhs->m_record.m_time_ns > rhs->m_record.m_time_ns;
+        }
+        return lhs->m_file_index > rhs->m_file_index;
+    }
+};
+
+void WriteStamp(LogBuffer_C& buffer, int64_t time_ns, uint64_t sequence,
+                size_t size) {
+    char* out = buffer.Reserve(kMaxStampChars);
+    size_t length = Kernels::FormatUnsigned(
+        static_cast<uint64_t>(std::max<int64_t>(time_ns, 0)), out);
+    out[length++] = ' ';
+    length += Kernels::FormatUnsigned(sequence, out + length);
+    out[length++] = ' ';
+    length += Kernels::FormatUnsigned(size, out + length);
+    out[length++] = ' ';
+    buffer.Commit(length);
+}
+
+}  // namespace
+
+std::string ThreadFileName(const std::string& base_name,
+                           std::string_view thread_id) {
+    std::string file_name = base_name;
+    file_name += '.';
+    file_name.append(thread_id.data(), thread_id.size());
+    return file_name;
+}
+
+bool ParseThreadFileRecord(std::string_view data, size_t& offset,
+                           LogThreadFileRecord_TP& record) {
+    size_t position = offset;
+    uint64_t time_ns;
+    uint64_t size;
+    if (!ParseNumber(data, position, time_ns) ||
+        !ParseNumber(data, position, record.m_sequence) ||
+        !ParseNumber(data, position, size) || size > data.size() - position) {
+        return false;
+    }
+    record.m_time_ns = static_cast<int64_t>(time_ns);
+    record.m_entry = data.substr(position, size);
+    offset = position + size;
+    return true;
+}
+
+uint64_t MergeThreadFiles(const std::vector<std::string>& file_names,
+                          std::ostream& out, bool keep_stamps,
+                          std::string& error) {
+    std::vector<std::unique_ptr<LogMappedFile_C>> files;
+    std::vector<MergeCursor_TP> cursors;
+    files.reserve(file_names.size());
+    cursors.reserve(file_names.size());
+    for (size_t i = 0; i < file_names.size(); ++i) {
+        files.emplace_back(new LogMappedFile_C());
+        if (files.back()->Open(file_names[i], error)) {
+            cursors.push_back(
+                MergeCursor_TP{files.back()->View(), 0, i, {}});
+        }
+    }
+
+    std::priority_queue<MergeCursor_TP*, std::vector<MergeCursor_TP*>,
+                        LaterEntry_TP>
+        heap;
+    auto advance = [&](MergeCursor_TP& cursor) {
+        if (ParseThreadFileRecord(cursor.m_data, cursor.m_offset,
+                                  cursor.m_record)) {
+            heap.push(&cursor);
+        } else if (cursor.m_offset != cursor.m_data.size()) {
+            // E.g. the last entry of a thread that died mid write
+            error += "Truncated entry in " +
+                     file_names[cursor.m_file_index] + " at offset " +
+                     std::to_string(cursor.m_offset) + "\n";
+        }
+    };
+    for (MergeCursor_TP& cursor : cursors) {
+        advance(cursor);
+    }
+
+    LogBuffer_C buffer;
+    uint64_t count = 0;
+    while (!heap.empty()) {
+        MergeCursor_TP* cursor = heap.top();
+        heap.pop();
+        const LogThreadFileRecord_TP& record = cursor->m_record;
+        if (keep_stamps) {
+            WriteStamp(buffer, record.m_time_ns, record.m_sequence,
+                       record.m_entry.size());
+        }
+        buffer.Append(record.m_entry);
+        if (buffer.Size() >= kThreadFileBufferBytes) {
+            out.write(buffer.Data(),
+                      static_cast<std::streamsize>(buffer.Size()));
+            buffer.Clear();
+        }
+        ++count;
+        advance(*cursor);
+    }
+    out.write(buffer.Data(), static_cast<std::streamsize>(buffer.Size()));
+    out.flush();
+    return count;
+}
+
+LogThreadFile_C::LogThreadFile_C(const std::string& file_name)
+    : m_fd(-1), m_sequence(0) {
+    m_file.open(file_name.c_str(), std::ofstream::out | std::ofstream::app |
+                                       std::ofstream::binary);
+    if (!m_file.is_open()) {
+        std::cerr << "[ERROR] : Couldn't open file " << file_name
+                  << " for write." << std::endl;
+    }
+#if defined(__linux__)
+    // Opened right after the stream, so both refer to the same file
+    if (m_file.is_open()) {
+        m_fd = open(file_name.c_str(), O_WRONLY | O_CLOEXEC);
+    }
+#endif
+}
+
+LogThreadFile_C::~LogThreadFile_C() {
+    Flush();
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+#endif
+}
+
+void LogThreadFile_C::Write(int64_t time_ns, const char* entry, size_t size,
+                            bool flush) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteStamp(m_buffer, time_ns, m_sequence++, size);
+    m_buffer.Append(entry, size);
+    if (flush || m_buffer.Size() >= kThreadFileBufferBytes) {
+        FlushBuffer();
+    }
+}
+
+void LogThreadFile_C::Flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushBuffer();
+}
+
+bool LogThreadFile_C::Sync() {
+    Flush();
+#if defined(__linux__)
+    // Outside the lock, the thread carries on while the disk catches up
+    return m_fd >= 0 && fdatasync(m_fd) == 0;
+#else
+    return true;
+#endif
+}
+
+void LogThreadFile_C::FlushBuffer() {
+    if (m_buffer.Size() == 0) {
+        return;
+    }
+    if (m_file.is_open()) {
+        m_file.write(m_buffer.Data(),
+                     static_cast<std::streamsize>(m_buffer.Size()));
+        m_file.flush();
+    }
+    m_buffer.Clear();
+}
+
+}  // end namespace Log
+}  // end namespace SN
@@ -0,0 +1,181 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_thread_file.h
+ *
+ * @brief Output file of a single logging thread and the merge of such files
+ * into one chronological stream.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Log includes
+#include "log_buffer.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct LogThreadFileRecord_TP
+ *
+ * @brief One entry of a per-thread file together with its stamp.
+ *
+ * Every entry is preceded by "<epoch ns> <sequence> <size> ", where size
+ * counts the bytes of the formatted entry including its line break. The
+ * size keeps entries whose message spans several lines in one piece.
+ *
+ */
+struct LogThreadFileRecord_TP {
+    int64_t m_time_ns = 0;    //!< time stamp, nanoseconds since the epoch
+    uint64_t m_sequence = 0;  //!< number of the entry within its thread
+    std::string_view m_entry;  //!< formatted entry including the line break
+};
+
+/**
+ * Names the file of a thread, the thread id is appended to the base name.
+ *
+ * @param base_name file name given to Logger_C::EnablePerThreadFiles()
+ * @param thread_id id of the logging thread
+ * @retval file name
+ */
+std::string ThreadFileName(const std::string& base_name,
+                           std::string_view thread_id);
+
+/**
+ * Parses the next entry of a per-thread file.
+ *
+ * @param data content of the file
+ * @param offset in: start of the entry, out: start of the next one
+ * @param record parsed entry, its view points into data
+ * @retval true on success, false at the end or on a truncated entry
+ */
+bool ParseThreadFileRecord(std::string_view data, size_t& offset,
+                           LogThreadFileRecord_TP& record);
+
+/**
+ * Merges per-thread files into one stream ordered by time stamp. Each file
+ * is memory mapped, entries with the same time stamp keep the order of the
+ * files given.
+ *
+ * @param file_names files to merge
+ * @param out merged entries
+ * @param keep_stamps write the stamp ahead of every entry, so the output can
+ * be merged again
+ * @param error description of the files which could not be read or ended in
+ * a truncated entry
+ * @retval number of entries written
+ */
+uint64_t MergeThreadFiles(const std::vector<std::string>& file_names,
+                          std::ostream& out, bool keep_stamps,
+                          std::string& error);
+
+/** SN::Log::LogThreadFile_C
+ *
+ * @b Description
+ * Log file owned by one thread. Entries are stamped and collected in a
+ * buffer of the thread, which goes to the file once it is full or an entry
+ * asks for a flush. Other threads only touch the file to flush or sync it,
+ * so the lock taken for writing is uncontended otherwise.
+ *
+ * The file is opened for appending. A thread id the system reuses continues
+ * the file of the thread that ended before, in time order.
+ *
+ * @b Resource @b Ownership
+ * Owns the file, the destructor writes what is still buffered.
+ */
+class LogThreadFile_C {
+   public:
+    /**
+     * Opens the file.
+     *
+     * @param file_name file to append to
+     */
+    explicit LogThreadFile_C(const std::string& file_name);
+
+    /**
+     * Writes the buffered entries and closes the file.
+     */
+    ~LogThreadFile_C();
+
+    LogThreadFile_C(const LogThreadFile_C& rhs) = delete;
+    LogThreadFile_C& operator=(const LogThreadFile_C& rhs) = delete;
+
+    /**
+     * Checks if the file could be opened.
+     *
+     * @retval true if open otherwise false
+     */
+    bool IsOpen() const { return m_file.is_open(); }
+
+    /**
+     * Stamps an entry and buffers it.
+     *
+     * @param time_ns time stamp of the record, nanoseconds since the epoch
+     * @param entry formatted entry including the line break
+     * @param size size of the entry
+     * @param flush write the buffer to the file right away
+     */
+    void Write(int64_t time_ns, const char* entry, size_t size, bool flush);
+
+    /**
+     * Writes the buffered entries to the file.
+     */
+    void Flush();
+
+    /**
+     * Writes the buffered entries and waits until the storage device has
+     * them.
+     *
+     * @retval true on success otherwise false
+     */
+    bool Sync();
+
+   private:
+    /** Writes the buffered entries, m_mutex must be held */
+    void FlushBuffer();
+
+    std::mutex m_mutex;  //!< guards the members below
+    std::ofstream m_file;
+    int m_fd;              //!< descriptor of the file for syncing, or -1
+    LogBuffer_C m_buffer;  //!< stamped entries not written yet
+    uint64_t m_sequence;   //!< sequence number of the next entry
+};  // end LogThreadFile_C
+
+}  // end namespace Log
+}  // end namespace SN
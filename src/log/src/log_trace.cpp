@@ -0,0 +1,267 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log_trace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "log_format_kernels.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+namespace {
+
+/** Default capacity, about a million events */
+constexpr size_t kDefaultMaxChunks = 256;
+
+uint64_t CurrentThreadId() {
+#if defined(__linux__)
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+    return std::hash<std::thread::id>()(std::this_thread::get_id());
+#endif
+}
+
+uint64_t CurrentProcessId() {
+#if defined(__linux__)
+    return static_cast<uint64_t>(getpid());
+#else
+    return 1;
+#endif
+}
+
+std::string CurrentThreadName() {
+#if defined(__linux__)
+    char name[16] = {0};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) {
+        return name;
+    }
+#endif
+    return std::string();
+}
+
+void WriteJsonString(std::ostream& stream, const char* text) {
+    stream << '"';
+    for (const char* ch = text; *ch != '\0'; ++ch) {
+        unsigned char value = static_cast<unsigned char>(*ch);
+        if (value == '"' || value == '\\') {
+            stream << '\\' << *ch;
+        } else if (value < 0x20) {
+            static constexpr char kHexDigits[] = "0123456789abcdef";
+            stream << "\\u00" << kHexDigits[value >> 4]
+                   << kHexDigits[value & 0xf];
+        } else {
+            stream << *ch;
+        }
+    }
+    stream << '"';
+}
+
+/** Writes nanoseconds as microseconds with three decimals, as Chrome wants */
+void WriteMicroSeconds(std::ostream& stream, int64_t ns) {
+    char buffer[Kernels::kMaxIntegerChars + 4];
+    if (ns < 0) {
+        stream << '-';
+        ns = -ns;
+    }
+    stream.write(buffer, static_cast<std::streamsize>(Kernels::FormatUnsigned(
+                             static_cast<uint64_t>(ns / 1000), buffer)));
+    int64_t fraction = ns % 1000;
+    buffer[0] = '.';
+    buffer[1] = static_cast<char>('0' + fraction / 100);
+    buffer[2] = static_cast<char>('0' + fraction / 10 % 10);
+    buffer[3] = static_cast<char>('0' + fraction % 10);
+    stream.write(buffer, 4);
+}
+
+int64_t ToEpochNs(int64_t ticks, const LogClockCalibration_TP* calibration) {
+    LogTimePoint_TP time_point;
+    time_point.m_ticks = ticks;
+    time_point.m_calibration = calibration;
+    return time_point.ToEpochNs();
+}
+
+}  // namespace
+
+thread_local TraceChunk_TP* Tracer_C::m_thread_chunk = nullptr;
+
+Tracer_C* Tracer_C::GetInstance() {
+    // Never destroyed, spans may still end in static destructors
+    static Tracer_C* instance = new Tracer_C();
+    return instance;
+}
+
+Tracer_C::Tracer_C()
+    : m_enabled(false),
+      m_dropped(0),
+      m_max_chunks(kDefaultMaxChunks),
+      m_exit_registered(false) {}
+
+void Tracer_C::Enable(const std::string& file_name /*= std::string()*/) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_file_name = file_name;
+        if (!m_file_name.empty() && !m_exit_registered) {
+            m_exit_registered = true;
+            std::atexit([] { Tracer_C::GetInstance()->Disable(); });
+        }
+    }
+    m_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer_C::Disable() {
+    m_enabled.store(false, std::memory_order_relaxed);
+    std::string file_name;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        file_name.swap(m_file_name);
+    }
+    if (!file_name.empty()) {
+        WriteChromeTrace(file_name);
+    }
+}
+
+void Tracer_C::SetCapacity(size_t max_events) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_chunks =
+        (max_events + TraceChunk_TP::kEvents - 1) / TraceChunk_TP::kEvents;
+}
+
+void Tracer_C::Reserve(size_t events) {
+    size_t chunks =
+        (events + TraceChunk_TP::kEvents - 1) / TraceChunk_TP::kEvents;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (m_spare_chunks.size() < chunks &&
+           m_chunks.size() + m_spare_chunks.size() < m_max_chunks) {
+        // Value initialization zeroes, and so touches, every page
+        m_spare_chunks.emplace_back(new TraceChunk_TP());
+    }
+}
+
+TraceChunk_TP* Tracer_C::NextChunk(
+    const LogClockCalibration_TP* calibration) {
+    bool first = m_thread_chunk == nullptr;
+    std::string thread_name = first ? CurrentThreadName() : std::string();
+    uint64_t thread_id =
+        first ? CurrentThreadId() : m_thread_chunk->m_thread_id;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_chunks.size() >= m_max_chunks) {
+        return nullptr;
+    }
+    if (m_spare_chunks.empty()) {
+        m_chunks.emplace_back(new TraceChunk_TP());
+    } else {
+        m_chunks.emplace_back(std::move(m_spare_chunks.back()));
+        m_spare_chunks.pop_back();
+    }
+    TraceChunk_TP* chunk = m_chunks.back().get();
+    chunk->m_thread_id = thread_id;
+    chunk->m_calibration = calibration;
+    if (first && !thread_name.empty()) {
+        m_thread_names.emplace_back(thread_id, thread_name);
+    }
+    m_thread_chunk = chunk;
+    return chunk;
+}
+
+void Tracer_C::WriteChromeTrace(std::ostream& stream) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Timestamps are written relative to the first event, absolute epoch
+    // microseconds lose precision in the viewers
+    int64_t origin = std::numeric_limits<int64_t>::max();
+    for (const auto& chunk : m_chunks) {
+        size_t count = chunk->m_count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent_TP& event = chunk->m_events[i];
+            origin = std::min(
+                origin, ToEpochNs(event.m_begin_ticks, chunk->m_calibration));
+        }
+    }
+
+    uint64_t pid = CurrentProcessId();
+    const char* separator = "\n";
+    stream << "{\"traceEvents\":[";
+    for (const auto& thread_name : m_thread_names) {
+        stream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":"
+               << pid << ",\"tid\":" << thread_name.first
+               << ",\"args\":{\"name\":";
+        WriteJsonString(stream, thread_name.second.c_str());
+        stream << "}}";
+        separator = ",\n";
+    }
+    for (const auto& chunk : m_chunks) {
+        size_t count = chunk->m_count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent_TP& event = chunk->m_events[i];
+            bool instant = event.m_end_ticks == TraceEvent_TP::kInstant;
+            int64_t begin_ns =
+                ToEpochNs(event.m_begin_ticks, chunk->m_calibration);
+            stream << separator << "{\"name\":";
+            WriteJsonString(stream, event.m_name);
+            stream << ",\"cat\":\"supernova\",\"ph\":\""
+                   << (instant ? "i\",\"s\":\"t" : "X") << "\",\"ts\":";
+            WriteMicroSeconds(stream, begin_ns - origin);
+            if (!instant) {
+                stream << ",\"dur\":";
+                WriteMicroSeconds(
+                    stream,
+                    ToEpochNs(event.m_end_ticks, chunk->m_calibration) -
+                        begin_ns);
+            }
+            stream << ",\"pid\":" << pid << ",\"tid\":" << chunk->m_thread_id
+                   << '}';
+            separator = ",\n";
+        }
+    }
+    stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+bool Tracer_C::WriteChromeTrace(const std::string& file_name) {
+    std::ofstream file(file_name.c_str());
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] : Couldn't open file " << file_name
+                  << " for write." << std::endl;
+        return false;
+    }
+    WriteChromeTrace(file);
+    return file.good();
+}
+
+}  // end namespace Log
+}  // end namespace SN
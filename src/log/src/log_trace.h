@@ -0,0 +1,297 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file log_trace.h
+ *
+ * @brief Tracer_C records timed spans and instant events and writes them as
+ * Chrome trace-event JSON.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#pragma once
+
+// Standard Includes
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Log includes
+#include "log_clock.h"
+
+// Outer namespace
+namespace SN {
+// Inner namespace
+namespace Log {
+
+/**
+ * @struct TraceEvent_TP
+ *
+ * @brief One span or instant event as recorded, converted at write time.
+ *
+ */
+struct TraceEvent_TP {
+    /** m_end_ticks of an instant event */
+    static constexpr int64_t kInstant = INT64_MIN;
+
+    const char* m_name;  //!< name, must have static storage duration
+    int64_t m_begin_ticks;
+    int64_t m_end_ticks;
+};
+
+/**
+ * @struct TraceChunk_TP
+ *
+ * @brief Fixed block of events filled by one thread.
+ *
+ * Only the owning thread writes, it publishes each event by a release store
+ * of m_count, so the writer of the trace can read the filled part at any
+ * time. All events of a chunk share one clock calibration, which keeps an
+ * event at 24 bytes.
+ *
+ */
+struct TraceChunk_TP {
+    static constexpr size_t kEvents = 4096;
+
+    uint64_t m_thread_id = 0;
+    const LogClockCalibration_TP* m_calibration = nullptr;
+    std::atomic<size_t> m_count{0};
+    TraceEvent_TP m_events[kEvents];
+};
+
+/** SN::Log::Tracer_C
+ *
+ * @b Description
+ * Collects the events of SN_TRACE_SCOPE and SN_TRACE_EVENT. Every thread
+ * appends to its own chunk, so recording takes no lock. A lock is only taken
+ * once per chunk of 4096 events to hand out the next one.
+ *
+ * Events are kept until the process exits, up to the capacity set by
+ * SetCapacity(). Events beyond it are counted and dropped.
+ * WriteChromeTrace() writes everything recorded so far in the Chrome
+ * trace-event format, which chrome://tracing and Perfetto open.
+ *
+ * @b Resource @b Ownership
+ * Owns every chunk, chunks outlive the threads which filled them.
+ */
+class Tracer_C {
+   public:
+    /**
+     * Gets the process wide tracer, never destroyed.
+     *
+     * @retval tracer object
+     */
+    static Tracer_C* GetInstance();
+
+    Tracer_C(const Tracer_C& rhs) = delete;
+    Tracer_C& operator=(const Tracer_C& rhs) = delete;
+
+    /**
+     * Starts recording.
+     *
+     * @param file_name trace file to write when recording is stopped by
+     * Disable() or at exit, empty to only write on request
+     */
+    void Enable(const std::string& file_name = std::string());
+
+    /**
+     * Stops recording and writes the trace file given to Enable().
+     */
+    void Disable();
+
+    /**
+     * Checks if events are recorded.
+     *
+     * @retval true if recording otherwise false
+     */
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Limits the number of events kept, rounded up to whole chunks.
+     *
+     * @param max_events maximum number of events
+     */
+    void SetCapacity(size_t max_events);
+
+    /**
+     * Allocates and touches chunks ahead of time, so recording doesn't take
+     * the page faults of fresh memory. Limited by the capacity.
+     *
+     * @param events number of events to make room for
+     */
+    void Reserve(size_t events);
+
+    /**
+     * Gets the number of events dropped for lack of capacity.
+     *
+     * @retval dropped events
+     */
+    uint64_t GetDroppedCount() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records an event on the calling thread.
+     *
+     * @param name event name with static storage duration
+     * @param begin time the event started
+     * @param end_ticks clock ticks when the event ended, or
+     * TraceEvent_TP::kInstant
+     */
+    void Record(const char* name, const LogTimePoint_TP& begin,
+                int64_t end_ticks) {
+        TraceChunk_TP* chunk = m_thread_chunk;
+        if (chunk == nullptr ||
+            chunk->m_count.load(std::memory_order_relaxed) ==
+                TraceChunk_TP::kEvents ||
+            chunk->m_calibration != begin.m_calibration) {
+            chunk = NextChunk(begin.m_calibration);
+            if (chunk == nullptr) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        size_t count = chunk->m_count.load(std::memory_order_relaxed);
+        chunk->m_events[count] = TraceEvent_TP{name, begin.m_ticks, end_ticks};
+        chunk->m_count.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * Records an instant event if recording.
+     *
+     * @param name event name with static storage duration
+     */
+    static void Instant(const char* name) {
+        Tracer_C* tracer = GetInstance();
+        if (tracer->IsEnabled()) {
+            tracer->Record(name, LogClock_C::GetInstance()->Now(),
+                           TraceEvent_TP::kInstant);
+        }
+    }
+
+    /**
+     * Writes the events recorded so far as Chrome trace-event JSON.
+     *
+     * @param stream stream to write to
+     */
+    void WriteChromeTrace(std::ostream& stream);
+
+    /**
+     * Writes the events recorded so far to a Chrome trace-event JSON file.
+     *
+     * @param file_name file to write
+     * @retval true on success otherwise false
+     */
+    bool WriteChromeTrace(const std::string& file_name);
+
+   private:
+    Tracer_C();
+
+    /**
+     * Hands the calling thread a new chunk.
+     *
+     * @param calibration clock calibration of the events in the chunk
+     * @retval chunk or null when the capacity is used up
+     */
+    TraceChunk_TP* NextChunk(const LogClockCalibration_TP* calibration);
+
+    static thread_local TraceChunk_TP* m_thread_chunk;
+
+    std::atomic<bool> m_enabled;
+    std::atomic<uint64_t> m_dropped;
+    size_t m_max_chunks;
+    std::string m_file_name;  //!< written by Disable()
+    bool m_exit_registered;
+    /** Chunks of every thread, in the order they were handed out */
+    std::vector<std::unique_ptr<TraceChunk_TP>> m_chunks;
+    /** Chunks allocated by Reserve() and not handed out yet */
+    std::vector<std::unique_ptr<TraceChunk_TP>> m_spare_chunks;
+    /** Thread names captured when a thread got its first chunk */
+    std::vector<std::pair<uint64_t, std::string>> m_thread_names;
+    std::mutex m_mutex;
+};  // end Tracer_C
+
+/** SN::Log::TraceScope_C
+ *
+ * @b Description
+ * Records a span from its construction to its destruction, see
+ * SN_TRACE_SCOPE. Costs one relaxed load when recording is off.
+ *
+ * @b Resource @b Ownership
+ * None
+ */
+class TraceScope_C {
+   public:
+    explicit TraceScope_C(const char* name) : m_name(name) {
+        if (Tracer_C::GetInstance()->IsEnabled()) {
+            m_begin = LogClock_C::GetInstance()->Now();
+        }
+    }
+
+    ~TraceScope_C() {
+        // No calibration means recording was off at the start
+        if (m_begin.m_calibration != nullptr) {
+            Tracer_C::GetInstance()->Record(
+                m_name, m_begin, LogClock_C::GetInstance()->Now().m_ticks);
+        }
+    }
+
+    TraceScope_C(const TraceScope_C& rhs) = delete;
+    TraceScope_C& operator=(const TraceScope_C& rhs) = delete;
+
+   private:
+    const char* m_name;
+    LogTimePoint_TP m_begin;
+};  // end TraceScope_C
+
+}  // end namespace Log
+}  // end namespace SN
+
+#define SN_TRACE_CONCAT_INNER(a, b) a##b
+#define SN_TRACE_CONCAT(a, b) SN_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * Tracing preprocessor Macros
+ *
+ * SN_TRACE_SCOPE records a span until the end of the enclosing scope,
+ * SN_TRACE_EVENT records an instant event. Names must be string literals or
+ * otherwise outlive the trace. Defining SN_TRACE_DISABLED compiles both out.
+ *
+ * @param name event name
+ */
+#ifndef SN_TRACE_DISABLED
+#define SN_TRACE_SCOPE(name) \
+    SN::Log::TraceScope_C SN_TRACE_CONCAT(sn_trace_scope_, __LINE__)(name)
+#define SN_TRACE_EVENT(name) SN::Log::Tracer_C::Instant(name)
+#else
+#define SN_TRACE_SCOPE(name) static_cast<void>(0)
+#define SN_TRACE_EVENT(name) static_cast<void>(0)
+#endif
@@ -25,13 +25,92 @@
 
 #include <stdlib.h>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
 #include <exception>
+#include <sstream>
 
 namespace SN {
 namespace Log {
 
+namespace {
+
+/** Buffer the calling thread formats its entries into */
+LogBuffer_C& ThreadEntryBuffer() {
+    thread_local LogBuffer_C entry;
+    return entry;
+}
+
+/** Syncs the data of a file written through another descriptor and closes
+ * the descriptor */
+bool SyncFile(int fd, const std::string& file_name) {
+#ifdef __linux__
+    // Syncing applies to the file, not to the descriptor, so a descriptor
+    // of our own covers what the ofstream has written
+    bool synced = fdatasync(fd) == 0;
+    close(fd);
+    if (!synced) {
+        std::cerr << "[ERROR] : Couldn't sync log file " << file_name
+                  << std::endl;
+        return false;
+    }
+#else
+    (void)fd;
+    (void)file_name;
+#endif
+    return true;
+}
+
+/** Formatted size at which a batch is written out in parts */
+constexpr size_t kBatchChunkBytes = 16384;
+
+/** Entries of a batch, formatted by the calling thread before writing */
+struct EntryBatch_TP {
+    void Clear() {
+        m_buffer.Clear();
+        m_records.clear();
+        m_ends.clear();
+        m_flush = false;
+    }
+
+    LogEntryBatch_TP View() const {
+        return LogEntryBatch_TP{m_buffer.Data(), m_buffer.Size(),
+                                m_records.data(), m_ends.data(),
+                                m_records.size()};
+    }
+
+    LogBuffer_C m_buffer;
+    std::vector<const LogRecord_TP*> m_records;
+    std::vector<size_t> m_ends;
+    bool m_flush = false;  //!< an entry asks for a flush
+};
+
+EntryBatch_TP& ThreadEntryBatch() {
+    thread_local EntryBatch_TP batch;
+    return batch;
+}
+
+/** Per-thread file of the calling thread */
+struct ThreadFile_TP {
+    /** Shared with Logger_C::m_thread_file_registry */
+    std::shared_ptr<LogThreadFile_C> m_file;
+    uint64_t m_generation = 0;  //!< settings the file was opened with
+};
+
+ThreadFile_TP& CurrentThreadFile() {
+    thread_local ThreadFile_TP file;
+    return file;
+}
+
+}  // namespace
+
 // Initialize static member variables
-Logger_C* Logger_C::m_instance = nullptr;
+std::atomic<Logger_C*> Logger_C::m_instance(nullptr);
 
 LogStreamMap_TP Logger_C::m_stream_map = {
     {LogSeverityLevel_TP::LOG_TRACE, &std::cout},
@@ -43,33 +122,69 @@ LogStreamMap_TP Logger_C::m_stream_map = {
 
 // Logger_C class member definitions
 Logger_C::Logger_C()
-    : m_active_log_level(LogSeverityLevel_TP::LOG_INFO),
-      m_time_stamp_mode(TimeStampMode_TP::DATE_TIME),
-      m_log_file_name("supernova_log.txt"),
-      m_format("[%T] [%F:%C %P] [%L] :: %S") {
+    : m_config(nullptr),
+      m_file_fd(-1),
+      m_backend(nullptr),
+      m_thread_files(0),
+      m_thread_files_generation(0) {
     m_str_stream.str(std::string());
     m_str_stream.clear();
-#ifdef _DEBUG
-    m_log_severity_level = LogSeverityLevel_TP::LOG_TRACE;
-    m_log_type = LogType_TP::BOTH;
-#else
-    m_log_severity_level = LogSeverityLevel_TP::LOG_INFO;
-    m_log_type = LogType_TP::FILE_LOG;
-#endif
+    std::lock_guard<std::mutex> lock(m_config_mutex);
+    PublishConfig(std::unique_ptr<LogConfig_TP>(new LogConfig_TP()));
+}
+
+Logger_C* Logger_C::CreateInstance() {
+    static std::once_flag created;
+    std::call_once(created, [] {
+        m_instance.store(new Logger_C(), std::memory_order_release);
+    });
+    return m_instance.load(std::memory_order_acquire);
+}
+
+void Logger_C::Prepare() {
+    LogClock_C::GetInstance();
+    LogRecordPool_C::GetInstance();
+    // The first date time stamp loads the time zone
+    char time_stamp[kTimeStampBufferSize];
+    FormatTimeStamp(TimeStampMode_TP::DATE_TIME, time_stamp);
+    PrepareThread();
+}
+
+void Logger_C::PrepareThread(size_t slabs /*= 64*/) {
+    LogRecordPool_C::GetInstance()->Reserve(slabs);
+    LogContext_C::GetThreadId();
+    // Grow the formatting buffer to the largest usual entry and run the
+    // formatter once, e.g. for the first use of the clock calibration
+    LogBuffer_C& entry = ThreadEntryBuffer();
+    std::memset(entry.Reserve(LogRecordPool_C::kSizeClasses[0]), 0,
+                LogRecordPool_C::kSizeClasses[0]);
+    LogRecord_TP record;
+    record.m_time = LogClock_C::GetInstance()->Now();
+    LogContext_C::Capture(record);
+    ConfigReader_C reader(*this);
+    FormatRecord(reader.Get(), record, entry);
+    entry.Clear();
 }
 
 void Logger_C::Init(const std::string& file_name, bool append /*= false*/) {
-    if (m_log_type == LogType_TP::FILE_LOG || m_log_type == LogType_TP::BOTH) {
+    LogClock_C::GetInstance()->Calibrate();
+    LogType_TP log_type;
+    {
+        ConfigReader_C reader(*this);
+        log_type = reader.Get().m_log_type;
+    }
+    if (log_type == LogType_TP::FILE_LOG || log_type == LogType_TP::BOTH) {
         if (!file_name.empty()) {
             try {
-                m_file_stream.open(file_name.c_str(),
-                                   append
-                                       ? std::ofstream::out | std::ofstream::app
-                                       : std::ofstream::out);
+                std::lock_guard<std::mutex> lock(m_write_mutex);
+                OpenLogFile(file_name,
+                            append ? std::ofstream::out | std::ofstream::app
+                                   : std::ofstream::out);
                 if (!m_file_stream.is_open()) {
                     throw std::runtime_error("Couldn't open file " + file_name +
                                              " for write.");
                 }
+                m_open_file_name = file_name;
             } catch (std::exception& ex) {
                 std::cerr << "[ERROR] : " << ex.what() << std::endl;
             }
@@ -84,31 +199,176 @@ void Logger_C::Init(const std::string& file_name, bool append /*= false*/) {
 }
 
 void Logger_C::FlushOut() {
-    if (m_str_stream.str().size() != 0) {
+    // Queued records go first so that the flush covers them
+    LogBackend_C* backend = m_backend.load(std::memory_order_acquire);
+    if (backend) {
+        backend->Flush();
+    }
+    SyncThreadFiles(false);
+    ThreadFile_TP& thread_file = CurrentThreadFile();
+    if (thread_file.m_file &&
+        thread_file.m_generation !=
+            m_thread_files.load(std::memory_order_relaxed)) {
+        thread_file.m_file.reset();
+    }
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    FlushOutputs();
+}
+
+bool Logger_C::Sync(std::chrono::milliseconds timeout,
+                    bool durable /*= true*/) {
+    std::future<bool> result = SyncAsync(durable);
+    return result.wait_for(timeout) == std::future_status::ready &&
+           result.get();
+}
+
+std::future<bool> Logger_C::SyncAsync(bool durable /*= true*/) {
+    {
+        std::lock_guard<std::mutex> lock(m_backend_mutex);
+        LogBackend_C* backend = m_backend.load(std::memory_order_acquire);
+        if (backend) {
+            return backend->RequestSync(durable);
+        }
+    }
+    std::promise<bool> result;
+    result.set_value(SyncOutputs(durable));
+    return result.get_future();
+}
+
+bool Logger_C::SyncOutputs(bool durable) {
+    bool result = true;
+    int fd = -1;
+    std::string file_name;
+    {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+        FlushOutputs();
+        if (durable) {
+            for (auto& sink : m_sinks) {
+                result = sink->Sync() && result;
+            }
+#ifdef __linux__
+            // A duplicate stays valid when the log file is switched
+            // meanwhile
+            if (m_file_stream.is_open() && m_file_fd >= 0) {
+                fd = fcntl(m_file_fd, F_DUPFD_CLOEXEC, 0);
+                file_name = m_open_file_name;
+                if (fd < 0) {
+                    std::cerr << "[ERROR] : Couldn't sync log file "
+                              << file_name << std::endl;
+                    result = false;
+                }
+            }
+#endif
+        }
+    }
+    // Outside the lock, writers carry on while the disk catches up
+    if (fd >= 0) {
+        result = SyncFile(fd, file_name) && result;
+    }
+    return SyncThreadFiles(durable) && result;
+}
+
+bool Logger_C::SyncThreadFiles(bool durable) {
+    std::vector<std::shared_ptr<LogThreadFile_C>> files;
+    {
+        std::lock_guard<std::mutex> lock(m_thread_file_mutex);
+        files.reserve(m_thread_file_registry.size());
+        for (const std::weak_ptr<LogThreadFile_C>& file :
+             m_thread_file_registry) {
+            if (std::shared_ptr<LogThreadFile_C> live = file.lock()) {
+                files.push_back(std::move(live));
+            }
+        }
+    }
+    // The files stay open while they are held here, even if their threads
+    // end meanwhile
+    bool result = true;
+    for (const std::shared_ptr<LogThreadFile_C>& file : files) {
+        if (durable) {
+            result = file->Sync() && result;
+        } else {
+            file->Flush();
+        }
+    }
+    return result;
+}
+
+void Logger_C::OpenLogFile(const std::string& file_name,
+                           std::ios_base::openmode mode) {
+    if (m_file_stream.is_open()) {
+        m_file_stream.close();
+    }
+#ifdef __linux__
+    if (m_file_fd >= 0) {
+        close(m_file_fd);
+        m_file_fd = -1;
+    }
+#endif
+    m_file_stream.open(file_name.c_str(), mode);
+#ifdef __linux__
+    // Opened right after the stream, so both refer to the same file even
+    // when it is renamed or replaced later on, e.g. by log rotation
+    if (m_file_stream.is_open()) {
+        m_file_fd = open(file_name.c_str(), O_WRONLY | O_CLOEXEC);
+    }
+#endif
+}
+
+void Logger_C::FlushOutputs() {
+    if (m_file_stream.is_open()) {
+        m_file_stream.flush();
+    }
+    for (auto& stream : m_stream_map) {
+        if (stream.second) {
+            stream.second->flush();
+        }
+    }
+    for (auto& sink : m_sinks) {
+        sink->Flush();
+    }
+}
+
+void Logger_C::WriteOut(const LogConfig_TP& config, const LogRecord_TP& record,
+                        const char* entry, size_t size, bool flush /*= true*/) {
+    LogSeverityLevel_TP level = record.m_level;
+    if (size != 0) {
+        flush = flush && config.m_flush_level <= level;
         // For file logs
-        if (m_log_type == LogType_TP::FILE_LOG ||
-            m_log_type == LogType_TP::BOTH) {
+        if (config.m_log_type == LogType_TP::FILE_LOG ||
+            config.m_log_type == LogType_TP::BOTH) {
             if (m_file_stream.is_open()) {
-                m_file_stream << m_str_stream.str() << std::endl;
-                // TODO (ayadav): Add some flushing policies to avoid overhead
-                // of writting to a file TRACE and DEBUG are less imporant
-                // messages than others. We need to think somethig in that
-                // direction
-                m_file_stream.flush();
+                m_file_stream.write(entry, static_cast<std::streamsize>(size));
+                // Less important messages are left in the stream buffer
+                // when the flush level is raised
+                if (flush) {
+                    m_file_stream.flush();
+                }
             }
         }
         // For console logs
-        if (m_log_type == LogType_TP::CONSOLE_LOG ||
-            m_log_type == LogType_TP::BOTH) {
-            auto& stream = m_stream_map[m_active_log_level];
+        auto& stream = m_stream_map[level];
+        if (config.m_log_type == LogType_TP::CONSOLE_LOG ||
+            config.m_log_type == LogType_TP::BOTH) {
             if (stream) {
-                *stream << m_str_stream.str() << std::endl;
-                stream->flush();
+                stream->write(entry, static_cast<std::streamsize>(size));
+                if (flush) {
+                    stream->flush();
+                }
+            }
+        }
+        // For additional outputs
+        if (config.m_log_type != LogType_TP::NO_LOG) {
+            for (auto& sink : m_sinks) {
+                sink->Write(record, entry, size);
+                if (flush) {
+                    sink->Flush();
+                }
             }
         }
         // Abort if a fatal log has been encountered
-        if (m_log_type != LogType_TP::NO_LOG &&
-            m_active_log_level == LogSeverityLevel_TP::LOG_FATAL) {
+        if (config.m_log_type != LogType_TP::NO_LOG &&
+            level == LogSeverityLevel_TP::LOG_FATAL) {
+            FlushOutputs();
 #ifdef _DEBUG
             std::cerr << "[ERROR] : A fatal log has been encountered."
                       << std::endl;
@@ -118,60 +378,529 @@ void Logger_C::FlushOut() {
     }
 }
 
-void Logger_C::LogWrite(LogSeverityLevel_TP level, std::string file,
-                        std::string func, uint32_t line, std::string message) {
-    // Compare with minimum log severity level
-    if (m_log_severity_level <= level) {
-        // Set the active log level
-        m_active_log_level = level;
-        // Crear the stream
-        m_str_stream.str(std::string());
-        m_str_stream.clear();
-        // Write the log
-        const char* format_ptr = m_format.c_str();
-        while (*format_ptr != 0) {
-            if (*format_ptr == '%') {
-                switch (*++format_ptr) {
-                    case 0:
-                        m_str_stream << '%' << std::endl;
-                        break;
-                    case '%':
-                        m_str_stream << '%';
-                        break;
-                    case 'T':
-                        m_str_stream << m_time_stamp_mode;
-                        break;
-                    case 'F':
-                        m_str_stream << file;
-                        break;
-                    case 'C':
-                        if (line != 0) {
-                            m_str_stream << line;
-                        } else {
-                            m_str_stream << "??";
-                        }
-                        break;
-                    case 'P':
-                        m_str_stream << func;
-                        break;
-                    case 'L':
-                        m_str_stream << level;
-                        break;
-                    case 'S':
-                        m_str_stream << message;
-                        break;
-                    default:
-                        break;
+void Logger_C::FormatRecord(const LogConfig_TP& config,
+                            const LogRecord_TP& record, LogBuffer_C& entry) {
+    for (const FormatOp_TP& op : config.m_format.GetOps()) {
+        switch (op.m_kind) {
+            case FormatOpKind_TP::LITERAL:
+                entry.Append(op.m_literal);
+                break;
+            case FormatOpKind_TP::TIME_STAMP:
+                entry.Commit(FormatTimeStamp(
+                    config.m_time_stamp_mode, record.m_time.ToEpochNs(),
+                    entry.Reserve(kTimeStampBufferSize)));
+                break;
+            case FormatOpKind_TP::FILE:
+                entry.Append(record.m_file);
+                break;
+            case FormatOpKind_TP::LINE:
+                if (record.m_line != 0) {
+                    entry.Commit(Kernels::FormatUnsigned(
+                        record.m_line,
+                        entry.Reserve(Kernels::kMaxIntegerChars)));
+                } else {
+                    entry.Append("??", 2);
                 }
-            } else {
-                m_str_stream << *format_ptr;
+                break;
+            case FormatOpKind_TP::FUNCTION:
+                entry.Append(record.m_function);
+                break;
+            case FormatOpKind_TP::LEVEL:
+                entry.Append(ToString(record.m_level));
+                break;
+            case FormatOpKind_TP::MESSAGE:
+                entry.Append(record.m_message);
+                break;
+            case FormatOpKind_TP::SAMPLE_RATE:
+                entry.Commit(Kernels::FormatUnsigned(
+                    record.m_sample_rate,
+                    entry.Reserve(Kernels::kMaxIntegerChars)));
+                break;
+            case FormatOpKind_TP::THREAD_ID:
+                entry.Append(record.ThreadId());
+                break;
+            case FormatOpKind_TP::THREAD_NAME:
+                entry.Append(record.ThreadName());
+                break;
+            case FormatOpKind_TP::CONTEXT:
+                entry.Append(record.Context());
+                break;
+        }
+    }
+    entry.Append('\n');
+}
+
+void Logger_C::WriteRecord(const LogConfig_TP& config,
+                           const LogRecord_TP& record) {
+    // Each thread formats into its own pooled buffer, only the output itself
+    // is serialized
+    LogBuffer_C& entry = ThreadEntryBuffer();
+    entry.Clear();
+    FormatRecord(config, record, entry);
+    // write out to avoid losing any log entry
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    WriteOut(config, record, entry.Data(), entry.Size());
+}
+
+void Logger_C::WriteThreadFile(const LogConfig_TP& config,
+                               const LogRecord_TP& record,
+                               uint64_t generation) {
+    ThreadFile_TP& thread_file = CurrentThreadFile();
+    if (thread_file.m_generation != generation) {
+        std::string file_name;
+        {
+            std::lock_guard<std::mutex> lock(m_thread_file_mutex);
+            file_name = ThreadFileName(m_thread_file_base,
+                                       LogContext_C::GetThreadId());
+        }
+        // The old file is written out before the new one is opened
+        thread_file.m_file.reset();
+        thread_file.m_file = std::make_shared<LogThreadFile_C>(file_name);
+        thread_file.m_generation = generation;
+        std::lock_guard<std::mutex> lock(m_thread_file_mutex);
+        // Files of ended threads are dropped while registering a new one
+        m_thread_file_registry.erase(
+            std::remove_if(m_thread_file_registry.begin(),
+                           m_thread_file_registry.end(),
+                           [](const std::weak_ptr<LogThreadFile_C>& file) {
+                               return file.expired();
+                           }),
+            m_thread_file_registry.end());
+        m_thread_file_registry.push_back(thread_file.m_file);
+    }
+    LogBuffer_C& entry = ThreadEntryBuffer();
+    entry.Clear();
+    FormatRecord(config, record, entry);
+    thread_file.m_file->Write(record.m_time.ToEpochNs(), entry.Data(),
+                              entry.Size(),
+                              config.m_flush_level <= record.m_level);
+    if (record.m_level == LogSeverityLevel_TP::LOG_FATAL) {
+        // The other threads' entries would be lost with the process
+        SyncThreadFiles(true);
+        std::abort();
+    }
+}
+
+void Logger_C::WriteBatchOut(std::vector<LogRecord_TP>& batch) {
+    ConfigReader_C reader(*this);
+    const LogConfig_TP& config = reader.Get();
+    LogBackend_C* backend = m_backend.load(std::memory_order_acquire);
+    if (backend == nullptr || (!config.m_load_shedding.m_enabled &&
+                               !m_shedder.IsShedding())) {
+        // Filtered by Submit() already
+        WriteRecords(config, batch.data(), batch.size(), false);
+        return;
+    }
+    auto start = LogLoadShedder_C::Clock_TP::now();
+    WriteRecords(config, batch.data(), batch.size(), false);
+    auto end = LogLoadShedder_C::Clock_TP::now();
+    double occupancy = static_cast<double>(backend->GetBatchDepth()) /
+                       static_cast<double>(backend->GetCapacity());
+    std::chrono::nanoseconds latency =
+        batch.empty() ? std::chrono::nanoseconds(0)
+                      : (end - start) / static_cast<int64_t>(batch.size());
+    if (m_shedder.Observe(config.m_load_shedding, config.m_log_severity_level,
+                          occupancy, latency, end)) {
+        // Call sites pick the new level up with their next message
+        LogCallSite_C::Invalidate();
+        // Idle ticks let the level come down when the load is gone
+        backend->SetIdleInterval(
+            m_shedder.IsShedding()
+                ? std::max(config.m_load_shedding.m_hold / 4,
+                           std::chrono::milliseconds(1))
+                : std::chrono::milliseconds(0));
+        LogRecord_TP summary;
+        if (!m_shedder.IsShedding() && m_shedder.TakeSummary(summary)) {
+            WriteRecords(config, &summary, 1, false);
+        }
+    }
+}
+
+void Logger_C::WriteBatch(const LogRecord_TP* records, size_t count) {
+    ConfigReader_C reader(*this);
+    const LogConfig_TP& config = reader.Get();
+    if (config.m_log_type == LogType_TP::NO_LOG) {
+        return;
+    }
+    // Records queued before go first
+    LogBackend_C* backend = m_backend.load(std::memory_order_acquire);
+    if (backend) {
+        backend->Flush();
+    }
+    WriteRecords(config, records, count, true);
+}
+
+void Logger_C::WriteRecords(const LogConfig_TP& config,
+                            const LogRecord_TP* records, size_t count,
+                            bool filter) {
+    EntryBatch_TP& batch = ThreadEntryBatch();
+    for (size_t i = 0; i < count; ++i) {
+        const LogRecord_TP& record = records[i];
+        if (filter && (config.m_gate_level > record.m_level ||
+                       !config.Accepts(record.m_level, record.m_file,
+                                       record.m_function, record.m_line))) {
+            continue;
+        }
+        FormatRecord(config, record, batch.m_buffer);
+        batch.m_records.push_back(&record);
+        batch.m_ends.push_back(batch.m_buffer.Size());
+        batch.m_flush = batch.m_flush || config.m_flush_level <= record.m_level;
+        if (batch.m_buffer.Size() >= kBatchChunkBytes) {
+            WriteEntries(config, batch.View(), batch.m_flush);
+            batch.Clear();
+        }
+    }
+    if (!batch.m_records.empty()) {
+        WriteEntries(config, batch.View(), batch.m_flush);
+        batch.Clear();
+    }
+}
+
+void Logger_C::WriteEntries(const LogConfig_TP& config,
+                            const LogEntryBatch_TP& batch, bool flush) {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    if ((config.m_log_type == LogType_TP::FILE_LOG ||
+         config.m_log_type == LogType_TP::BOTH) &&
+        m_file_stream.is_open()) {
+        m_file_stream.write(batch.m_data,
+                            static_cast<std::streamsize>(batch.m_size));
+    }
+    if (config.m_log_type == LogType_TP::CONSOLE_LOG ||
+        config.m_log_type == LogType_TP::BOTH) {
+        // One write per run of entries going to the same stream
+        size_t begin = 0;
+        for (size_t i = 0; i < batch.m_count;) {
+            std::ostream* stream = m_stream_map[batch.m_records[i]->m_level];
+            size_t end = i + 1;
+            while (end < batch.m_count &&
+                   m_stream_map[batch.m_records[end]->m_level] == stream) {
+                ++end;
+            }
+            if (stream) {
+                stream->write(batch.m_data + begin,
+                              static_cast<std::streamsize>(
+                                  batch.m_ends[end - 1] - begin));
+            }
+            begin = batch.m_ends[end - 1];
+            i = end;
+        }
+    }
+    if (config.m_log_type != LogType_TP::NO_LOG) {
+        for (auto& sink : m_sinks) {
+            sink->WriteBatch(batch);
+        }
+    }
+    // One flush per batch instead of one per record
+    if (flush) {
+        FlushOutputs();
+    }
+}
+
+void Logger_C::LogWrite(LogSeverityLevel_TP level, std::string_view file,
+                        std::string_view func, uint32_t line,
+                        std::string_view message,
+                        uint32_t sample_rate /*= 1*/) {
+    LogRecord_TP record;
+    record.m_level = level;
+    record.m_file = file;
+    record.m_function = func;
+    record.m_line = line;
+    record.m_sample_rate = sample_rate;
+    record.m_message = message;
+    Submit(record);
+}
+
+void Logger_C::SubmitAccepted(const LogConfig_TP& config,
+                              LogRecord_TP& record) {
+    if (record.m_level < m_shedder.GetLevel()) {
+        m_shedder.CountShed(record.m_level);
+        return;
+    }
+    // Only the raw counter is read here, the conversion to wall time is done
+    // by whichever thread formats the record
+    record.m_time = LogClock_C::GetInstance()->Now();
+    if (config.m_format.UsesThreadContext()) {
+        // Rendered when it changed, only referred to here
+        LogContext_C::Capture(record);
+    }
+    uint64_t thread_files = m_thread_files.load(std::memory_order_relaxed);
+    if (thread_files != 0) {
+        WriteThreadFile(config, record, thread_files);
+        return;
+    }
+    LogBackend_C* backend = m_backend.load(std::memory_order_acquire);
+    if (backend) {
+        if (record.m_level == LogSeverityLevel_TP::LOG_FATAL) {
+            // Keep the order and don't lose the queue to the abort
+            backend->Flush();
+        } else {
+            record.OwnPayload();
+            if (backend->Push(record, config.m_overflow) !=
+                PushResult_TP::STOPPED) {
+                return;
             }
-            ++format_ptr;
         }
-        // flush out to avoid losing any log entry
-        FlushOut();
     }
+    WriteRecord(config, record);
+}
+
+void Logger_C::EnableAsyncLogging(
+    size_t queue_capacity /*= 8192*/,
+    const BackendThreadSettings_TP& thread_settings
+    /*= BackendThreadSettings_TP()*/) {
+    std::lock_guard<std::mutex> lock(m_backend_mutex);
+    if (m_backend.load(std::memory_order_relaxed) != nullptr) {
+        return;
+    }
+    if (m_backends.empty()) {
+        // Write whatever is still queued when the process exits normally
+        std::atexit([] { Logger_C::GetInstance()->DisableAsyncLogging(); });
+    }
+    m_backends.emplace_back(new LogBackend_C(
+        queue_capacity,
+        [this](std::vector<LogRecord_TP>& batch) { WriteBatchOut(batch); },
+        [this](bool durable) { return SyncOutputs(durable); },
+        thread_settings));
+    m_backend.store(m_backends.back().get(), std::memory_order_release);
+}
+
+void Logger_C::DisableAsyncLogging() {
+    std::lock_guard<std::mutex> lock(m_backend_mutex);
+    LogBackend_C* backend = m_backend.exchange(nullptr);
+    if (backend) {
+        backend->Stop();
+    }
+    // Without a queue there is no load to shed
+    if (m_shedder.Restore()) {
+        LogCallSite_C::Invalidate();
+        LogRecord_TP summary;
+        if (m_shedder.TakeSummary(summary)) {
+            ConfigReader_C reader(*this);
+            WriteRecords(reader.Get(), &summary, 1, false);
+        }
+    }
+}
+
+void Logger_C::SetOverflowPolicy(OverflowPolicy_TP policy,
+                                 LogSeverityLevel_TP level,
+                                 std::chrono::milliseconds block_timeout) {
+    UpdateConfig([policy, level, block_timeout](LogConfig_TP& config) {
+        config.m_overflow = {policy, level, block_timeout};
+    });
+}
+
+void Logger_C::SetLoadShedding(const LoadSheddingSettings_TP& settings) {
+    UpdateConfig([&settings](LogConfig_TP& config) {
+        config.m_load_shedding = settings;
+    });
+}
+
+void Logger_C::AddSink(std::shared_ptr<LogSink_C> sink) {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    m_sinks.push_back(std::move(sink));
+}
+
+void Logger_C::RemoveSink(const std::shared_ptr<LogSink_C>& sink) {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    m_sinks.erase(std::remove(m_sinks.begin(), m_sinks.end(), sink),
+                  m_sinks.end());
+}
+
+bool Logger_C::EnableSharedMemoryLogging(const std::string& name,
+                                         size_t capacity, size_t slot_size) {
+    std::string error;
+    std::unique_ptr<ShmLogRing_C> ring =
+        ShmLogRing_C::Open(name, capacity, slot_size, error);
+    if (!ring) {
+        std::cerr << "[ERROR] : " << error << std::endl;
+        return false;
+    }
+    AddSink(std::make_shared<ShmLogSink_C>(std::move(ring)));
+    return true;
+}
+
+void Logger_C::EnablePerThreadFiles(const std::string& base_name) {
+    std::lock_guard<std::mutex> lock(m_thread_file_mutex);
+    m_thread_file_base = base_name;
+    m_thread_files.store(++m_thread_files_generation,
+                         std::memory_order_relaxed);
+}
+
+void Logger_C::DisablePerThreadFiles() {
+    m_thread_files.store(0, std::memory_order_relaxed);
 }
 
+bool Logger_C::EnableSocketLogging(const std::string& endpoint,
+                                   const SocketSinkOptions_TP& options) {
+    std::shared_ptr<SocketSink_C> sink =
+        std::make_shared<SocketSink_C>(endpoint, options);
+    if (!sink->IsValid()) {
+        return false;
+    }
+    AddSink(std::move(sink));
+    return true;
+}
+
+uint64_t Logger_C::GetDroppedCount(LogSeverityLevel_TP level) {
+    std::lock_guard<std::mutex> lock(m_backend_mutex);
+    uint64_t dropped = 0;
+    for (const auto& backend : m_backends) {
+        dropped += backend->GetDroppedCount(level);
+    }
+    return dropped;
+}
+
+void Logger_C::SetLogSeverityLevel(LogSeverityLevel_TP severity_level) {
+    UpdateConfig([severity_level](LogConfig_TP& config) {
+        config.m_log_severity_level = severity_level;
+        config.UpdateGateLevel();
+    });
+}
+
+void Logger_C::SetTimeStampMode(TimeStampMode_TP time_stamp_mode) {
+    UpdateConfig([time_stamp_mode](LogConfig_TP& config) {
+        config.m_time_stamp_mode = time_stamp_mode;
+    });
+}
+
+void Logger_C::SetLogType(LogType_TP log_type) {
+    UpdateConfig(
+        [log_type](LogConfig_TP& config) { config.m_log_type = log_type; });
+}
+
+void Logger_C::SetLogFileName(const std::string& file_name) {
+    UpdateConfig([&file_name](LogConfig_TP& config) {
+        config.m_log_file_name = file_name;
+    });
+}
+
+void Logger_C::SetFormat(const std::string& format) {
+    LogFormat_C compiled(format);
+    UpdateConfig([&compiled](LogConfig_TP& config) {
+        config.m_format = compiled;
+    });
+}
+
+void Logger_C::SetFlushLevel(LogSeverityLevel_TP flush_level) {
+    UpdateConfig([flush_level](LogConfig_TP& config) {
+        config.m_flush_level = flush_level;
+    });
+}
+
+bool Logger_C::AddSiteRule(const std::string& spec,
+                           LogSeverityLevel_TP level) {
+    LogSiteRule_TP rule;
+    if (!ParseLogSiteRule(spec, level, rule)) {
+        std::cerr << "[ERROR] : Invalid log site rule " << spec << std::endl;
+        return false;
+    }
+    UpdateConfig([&rule](LogConfig_TP& config) {
+        config.m_site_rules.push_back(std::move(rule));
+        config.UpdateGateLevel();
+    });
+    return true;
+}
+
+void Logger_C::ClearSiteRules() {
+    UpdateConfig([](LogConfig_TP& config) {
+        config.m_site_rules.clear();
+        config.UpdateGateLevel();
+    });
+}
+
+void Logger_C::SetBlobLimit(size_t limit) {
+    UpdateConfig(
+        [limit](LogConfig_TP& config) { config.m_blob_limit = limit; });
+}
+
+void Logger_C::SetConfig(const LogConfig_TP& config) {
+    std::unique_ptr<LogConfig_TP> copy(new LogConfig_TP(config));
+    copy->UpdateGateLevel();
+    std::lock_guard<std::mutex> lock(m_config_mutex);
+    PublishConfig(std::move(copy));
+}
+
+void Logger_C::PublishConfig(std::unique_ptr<LogConfig_TP> config) {
+    // Sequentially consistent with ConfigReader_C, which also keeps a
+    // reader from seeing a partially constructed snapshot
+    m_config.store(config.get(), std::memory_order_seq_cst);
+    if (m_current_config) {
+        m_retired_configs.push_back(RetiredConfig_TP{
+            std::move(m_current_config), (1u << kConfigReaderShards) - 1});
+    }
+    m_current_config = std::move(config);
+    // After the store, a site which sees the new generation sees the new
+    // snapshot as well
+    LogCallSite_C::Invalidate();
+    ReclaimConfigs();
+}
+
+void Logger_C::ReclaimConfigs() {
+    // A reader registered after a counter was seen at zero has loaded a
+    // newer snapshot, so one zero per shard after the retirement is enough
+    uint32_t idle_shards = 0;
+    for (size_t i = 0; i < kConfigReaderShards; ++i) {
+        if (m_config_readers[i].m_count.load(std::memory_order_seq_cst) ==
+            0) {
+            idle_shards |= 1u << i;
+        }
+    }
+    m_retired_configs.erase(
+        std::remove_if(m_retired_configs.begin(), m_retired_configs.end(),
+                       [idle_shards](RetiredConfig_TP& retired) {
+                           retired.m_busy_shards &= ~idle_shards;
+                           return retired.m_busy_shards == 0;
+                       }),
+        m_retired_configs.end());
+}
+
+bool Logger_C::LoadConfigFile(const std::string& file_name) {
+    std::ifstream file(file_name.c_str());
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] : Couldn't open config file " << file_name
+                  << std::endl;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+
+    std::string log_file_name;
+    {
+        std::lock_guard<std::mutex> lock(m_config_mutex);
+        std::unique_ptr<LogConfig_TP> config(
+            new LogConfig_TP(*m_current_config));
+        std::string error;
+        if (!ParseLogConfig(text.str(), *config, error)) {
+            std::cerr << "[ERROR] : " << file_name << ": " << error
+                      << std::endl;
+            return false;
+        }
+        log_file_name = config->m_log_file_name;
+        PublishConfig(std::move(config));
+    }
+
+    // Move the output over when the config names another log file
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    if (m_file_stream.is_open() && log_file_name != m_open_file_name) {
+        OpenLogFile(log_file_name, std::ofstream::out | std::ofstream::app);
+        if (!m_file_stream.is_open()) {
+            std::cerr << "[ERROR] : Couldn't open file " << log_file_name
+                      << " for write." << std::endl;
+        }
+        m_open_file_name = log_file_name;
+    }
+    return true;
+}
+
+bool Logger_C::WatchConfigFile(const std::string& file_name) {
+    bool loaded = LoadConfigFile(file_name);
+    m_config_watcher.reset();
+    m_config_watcher.reset(new LogConfigWatcher_C(
+        file_name, [this](const std::string& name) { LoadConfigFile(name); }));
+    return loaded;
+}
+
+void Logger_C::StopWatchingConfigFile() { m_config_watcher.reset(); }
+
 }  // end namespace Log
 }  // namespace SN
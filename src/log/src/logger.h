@@ -34,13 +34,32 @@
 #pragma once
 
 // Standards includes
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // Log includes
+#include "log_backend.h"
+#include "log_call_site.h"
+#include "log_config.h"
+#include "log_context.h"
+#include "log_load_shedder.h"
 #include "log_message_sink.h"
+#include "log_record.h"
+#include "log_sampling.h"
+#include "log_shm_ring.h"
+#include "log_socket_sink.h"
+#include "log_thread_file.h"
+#include "log_sink.h"
 #include "logging_attributes.h"
 
 // Outer namespace
@@ -93,18 +112,41 @@ class Logger_C {
      * @retval logger object
      */
     static Logger_C* GetInstance() {
-        if (m_instance == nullptr) {
-            m_instance = new Logger_C();
+        Logger_C* instance = m_instance.load(std::memory_order_acquire);
+        if (instance == nullptr) {
+            instance = CreateInstance();
         }
-        return m_instance;
+        return instance;
     }
 
+    /**
+     * Pays the one-off costs of logging ahead of the first message: creates
+     * the logger, the clock and the record pool, loads the time zone and
+     * prepares the calling thread, see PrepareThread().
+     *
+     * Call it after Init() and the configuration, e.g. before entering a
+     * control loop, so the first message costs the same as any later one.
+     */
+    void Prepare();
+
+    /**
+     * Prepares the calling thread for logging: allocates and touches its
+     * pooled buffers and its formatting buffer, and caches its id and name.
+     * Threads which log from a latency critical loop call it once at start.
+     *
+     * @param slabs number of pooled message buffers to keep ready
+     */
+    void PrepareThread(size_t slabs = 64);
+
     /**
      * Open the log file and initialize the out file stream.
      *
      * Checks empty filename error and throws an exception
      * if any run-time error has occurred while opening the log file.
      *
+     * Also calibrates the clock the time stamps are taken from, see
+     * LogClock_C.
+     *
      * @param file_name the name of a log file
      * @param append  a flag for opening mode append
      * @retval None
@@ -119,6 +161,29 @@ class Logger_C {
      */
     void FlushOut();
 
+    /**
+     * Waits until every record logged before the call has been written and
+     * flushed, and with durable set synced to disk by the log file and every
+     * sink. Other threads keep logging meanwhile, e.g. at a checkpoint.
+     *
+     * @param timeout longest wait
+     * @param durable true to sync to disk, false to flush only
+     * @retval true on success, false on failure or timeout
+     */
+    bool Sync(std::chrono::milliseconds timeout, bool durable = true);
+
+    /**
+     * Starts a Sync() without waiting for it.
+     *
+     * With asynchronous logging the backend thread syncs once it has
+     * written the records queued before the call, otherwise the calling
+     * thread syncs right away.
+     *
+     * @param durable true to sync to disk, false to flush only
+     * @retval result of the sync, see Sync()
+     */
+    std::future<bool> SyncAsync(bool durable = true);
+
     /**
      * Writes log messages into the steam
      *
@@ -127,12 +192,140 @@ class Logger_C {
      * @param func function name at point of log
      * @param line line number at point of log
      * @param message message to be logged
+     * @param sample_rate number of hits the message stands for when the call
+     * site is sampled, rendered by the %R format token
      *
      * @retval None
      *
      */
-    void LogWrite(LogSeverityLevel_TP level, std::string file, std::string func,
-                  uint32_t line, std::string message);
+    void LogWrite(LogSeverityLevel_TP level, std::string_view file,
+                  std::string_view func, uint32_t line,
+                  std::string_view message, uint32_t sample_rate = 1);
+
+    /**
+     * Logs a record, either directly or through the backend thread when
+     * asynchronous logging is enabled.
+     *
+     * FATAL records are always written synchronously after the backend has
+     * drained its queue.
+     *
+     * @param record record to log, the time stamp is taken here
+     * @param site_checked true when the call site has already checked the
+     * level against the site rules, e.g. through LogCallSite_C
+     */
+    void Submit(LogRecord_TP& record, bool site_checked = false) {
+        // One snapshot for the whole message, settings published meanwhile
+        // are picked up by the next one
+        ConfigReader_C reader(*this);
+        const LogConfig_TP& config = reader.Get();
+        // Compare with minimum log severity level, the rule scan is skipped
+        // when the call site has its decision cached
+        if (config.m_gate_level > record.m_level ||
+            (!site_checked &&
+             !config.Accepts(record.m_level, record.m_file,
+                             record.m_function, record.m_line))) {
+            return;
+        }
+        SubmitAccepted(config, record);
+    }
+
+    /**
+     * Writes records built by the caller, e.g. when replaying a recorded run
+     * or forwarding the log of another device. Time stamps and locations
+     * are taken from the records, use LogTimePoint_TP::FromEpochNs() for
+     * recorded wall times.
+     *
+     * The records are filtered by level and formatted in one pass. The
+     * entries go to each output in chunks of about 16 KiB, one contiguous
+     * write per chunk, and entries of other threads may fall between two
+     * chunks. A chunk is flushed only when it holds a record at or above
+     * the flush level. Records queued by asynchronous logging are written
+     * first.
+     * Replayed FATAL records are written like any other, they don't abort.
+     *
+     * @param records records to write
+     * @param count number of records
+     */
+    void WriteBatch(const LogRecord_TP* records, size_t count);
+
+    /**
+     * Moves formatting and output onto a backend thread. Logging threads
+     * only queue the record, the configured overflow policy applies when the
+     * queue is full.
+     *
+     * @param queue_capacity number of records the queue holds
+     * @param thread_settings name, CPU affinity, scheduling policy and wait
+     * strategy of the backend thread
+     */
+    void EnableAsyncLogging(size_t queue_capacity = 8192,
+                            const BackendThreadSettings_TP& thread_settings =
+                                BackendThreadSettings_TP());
+
+    /**
+     * Writes the queued records, stops the backend thread and returns to
+     * synchronous logging. Called at exit as well.
+     */
+    void DisableAsyncLogging();
+
+    /**
+     * Checks if the records are written by a backend thread.
+     *
+     * @retval true if asynchronous logging is enabled otherwise false
+     */
+    bool IsAsyncLogging() const {
+        return m_backend.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+     * Sets what asynchronous logging does when its queue is full.
+     *
+     * BLOCK with a timeout of one second is the default value.
+     *
+     * @param policy overflow policy
+     * @param level with DROP_BELOW_LEVEL the lowest level which is never
+     * dropped for lack of room
+     * @param block_timeout with BLOCK the longest wait for room
+     */
+    void SetOverflowPolicy(
+        OverflowPolicy_TP policy,
+        LogSeverityLevel_TP level = LogSeverityLevel_TP::LOG_ERROR,
+        std::chrono::milliseconds block_timeout =
+            std::chrono::milliseconds(1000));
+
+    /**
+     * Gets the number of records dropped by the overflow policy.
+     *
+     * @param level log severity level
+     * @retval dropped records at the level since the logger was created
+     */
+    uint64_t GetDroppedCount(LogSeverityLevel_TP level);
+
+    /**
+     * Sets when asynchronous logging raises its effective level on its own
+     * under overload, see LoadSheddingSettings_TP. The configured level is
+     * restored when the pressure is gone and a WARN record tells what has
+     * been shed meanwhile.
+     *
+     * Off by default.
+     *
+     * @param settings load shedding settings
+     */
+    void SetLoadShedding(const LoadSheddingSettings_TP& settings);
+
+    /**
+     * Gets the load shedding state, e.g. the raised level and the number of
+     * messages shed.
+     *
+     * @retval load shedder
+     */
+    const LogLoadShedder_C& GetLoadShedder() const { return m_shedder; }
+
+    /**
+     * Counts a message suppressed at its call site by load shedding.
+     *
+     * @param level severity level of the message
+     */
+    void CountShed(LogSeverityLevel_TP level) { m_shedder.CountShed(level); }
     /**
      * Sets the minimum severity level of the logger.
      *
@@ -142,27 +335,46 @@ class Logger_C {
      *
      * @param severity_level serverity to set
      */
-    void SetLogSeverityLevel(LogSeverityLevel_TP severity_level) {
-        m_log_severity_level = severity_level;
-    }
+    void SetLogSeverityLevel(LogSeverityLevel_TP severity_level);
 
     /**
      * Gets the minimum severity level of the logger.
      *
      * @retval minimum log severity level
      */
-    LogSeverityLevel_TP GetLogSeverityLevel() { return m_log_severity_level; }
+    LogSeverityLevel_TP GetLogSeverityLevel() const {
+        ConfigReader_C reader(*this);
+        return reader.Get().m_log_severity_level;
+    }
 
     /**
      * Checks if this logger accepts a given log severity level.
      *
      * This logger will only log messages a given severity level or higher.
+     * With per component levels configured this is the lowest level any
+     * component accepts.
      *
      * @param severity_level log level to check for
      * @retval true if the logger accepts the log level otherwise false
      */
     bool IsLogSeverityLevel(LogSeverityLevel_TP severity_level) const {
-        return m_log_severity_level <= severity_level;
+        ConfigReader_C reader(*this);
+        return reader.Get().m_gate_level <= severity_level;
+    }
+
+    /**
+     * Gets the minimum level of a call site, see LogConfig_TP::MinimumLevel().
+     *
+     * @param file file name at point of log
+     * @param function function name at point of log
+     * @param line line number at point of log
+     * @retval minimum level
+     */
+    LogSeverityLevel_TP GetMinimumLevel(std::string_view file,
+                                        std::string_view function,
+                                        uint32_t line) const {
+        ConfigReader_C reader(*this);
+        return reader.Get().MinimumLevel(file, function, line);
     }
 
     /**
@@ -172,9 +384,7 @@ class Logger_C {
      *
      * @param time_stamp_mode time stamp mode to set
      */
-    void SetTimeStampMode(TimeStampMode_TP time_stamp_mode) {
-        m_time_stamp_mode = time_stamp_mode;
-    }
+    void SetTimeStampMode(TimeStampMode_TP time_stamp_mode);
 
     /**
      * Gets the mode of the current timestamp.
@@ -191,7 +401,10 @@ class Logger_C {
      *
      * @retval current timestamp mode
      */
-    TimeStampMode_TP GetTimeStampMode() { return m_time_stamp_mode; }
+    TimeStampMode_TP GetTimeStampMode() const {
+        ConfigReader_C reader(*this);
+        return reader.Get().m_time_stamp_mode;
+    }
 
     /**
      * Sets the type of log to display the log either on the console or save in
@@ -201,7 +414,7 @@ class Logger_C {
      *
      * @param log_type type of log to set
      */
-    void SetLogType(LogType_TP log_type) { m_log_type = log_type; }
+    void SetLogType(LogType_TP log_type);
 
     /**
      * Enables the logger to display the logs on the console.
@@ -209,7 +422,7 @@ class Logger_C {
      * Sets the m_log_type to CONSOLE_LOG
      *
      */
-    void EnableConsoleLogging() { m_log_type = LogType_TP::CONSOLE_LOG; }
+    void EnableConsoleLogging() { SetLogType(LogType_TP::CONSOLE_LOG); }
 
     /**
      * Enables the logger to save the log entries in the log file.
@@ -217,7 +430,7 @@ class Logger_C {
      * Sets the m_log_type to FILE_LOG
      *
      */
-    void EnableFileLogging() { m_log_type = LogType_TP::FILE_LOG; }
+    void EnableFileLogging() { SetLogType(LogType_TP::FILE_LOG); }
 
     /**
      * Sets the fullpath and name of the log file.
@@ -226,9 +439,7 @@ class Logger_C {
      *
      * @param file_name log file name to set
      */
-    void SetLogFileName(const std::string& file_name) {
-        m_log_file_name = file_name;
-    }
+    void SetLogFileName(const std::string& file_name);
 
     /**
      * Gets the log file name
@@ -236,17 +447,25 @@ class Logger_C {
      * @retval current log file name
      *
      */
-    const std::string& GetLogFileName() const { return m_log_file_name; }
+    std::string GetLogFileName() const {
+        ConfigReader_C reader(*this);
+        return reader.Get().m_log_file_name;
+    }
 
     /**
      * Sets the log format string
      *
      * "[%T] [%F:%C %P] [%L] :: %S" is the deafult format string.
      *
+     * Supported tokens: %T time stamp, %F file, %C line, %P function,
+     * %L severity level, %S message, %R sampling rate of the record,
+     * %I thread id, %N thread name, %X context attributes of the thread (see
+     * SN_LOG_SCOPE_CONTEXT) and %% a literal percent sign.
+     *
      * @param format a format string to set
      *
      */
-    void SetFormat(const std::string& format) { m_format = format; };
+    void SetFormat(const std::string& format);
 
     /**
      * Gets the log format string
@@ -254,7 +473,176 @@ class Logger_C {
      * @retval current format string
      *
      */
-    const std::string& GetFormat() const { return m_format; }
+    std::string GetFormat() const {
+        ConfigReader_C reader(*this);
+        return reader.Get().m_format.GetFormatString();
+    }
+
+    /**
+     * Sets the minimum level of messages which flush the output streams.
+     *
+     * LOG_TRACE, i.e. flushing every message, is the default value.
+     *
+     * @param flush_level minimum level to flush at
+     */
+    void SetFlushLevel(LogSeverityLevel_TP flush_level);
+
+    /**
+     * Adds a rule setting the minimum level of the log sites in some files,
+     * functions or lines, e.g. AddSiteRule("net.cpp@Reconnect", LOG_DEBUG)
+     * to debug one function while the rest stays at INFO. A later rule wins
+     * over an earlier one for the sites both match.
+     *
+     * @param spec FILE_GLOB[:FIRST[-LAST]][@FUNCTION], see ParseLogSiteRule()
+     * @param level minimum level of the matching sites
+     * @retval true on success, false if the spec is malformed
+     */
+    bool AddSiteRule(const std::string& spec, LogSeverityLevel_TP level);
+
+    /**
+     * Removes all site rules.
+     */
+    void ClearSiteRules();
+
+    /**
+     * Sets how many bytes SN_LOG_HEX and SN_LOG_BASE64 encode at most, the
+     * rest of the data is only counted in the message.
+     *
+     * 256 is the default value.
+     *
+     * @param limit bytes per message
+     */
+    void SetBlobLimit(size_t limit);
+
+    /**
+     * Gets the bytes SN_LOG_HEX and SN_LOG_BASE64 encode per message.
+     *
+     * @retval bytes per message
+     */
+    size_t GetBlobLimit() const {
+        ConfigReader_C reader(*this);
+        return reader.Get().m_blob_limit;
+    }
+
+    /**
+     * Gets a copy of the current configuration snapshot.
+     *
+     * @retval current configuration
+     */
+    LogConfig_TP GetConfig() const {
+        ConfigReader_C reader(*this);
+        return reader.Get();
+    }
+
+    /**
+     * Publishes a new configuration snapshot.
+     *
+     * @param config configuration to publish
+     */
+    void SetConfig(const LogConfig_TP& config);
+
+    /**
+     * Gets the number of replaced snapshots not reclaimed yet.
+     *
+     * @retval retired snapshots
+     */
+    size_t GetRetiredConfigCount() {
+        std::lock_guard<std::mutex> lock(m_config_mutex);
+        return m_retired_configs.size();
+    }
+
+    /**
+     * Loads a configuration file and publishes it.
+     *
+     * The log file is reopened in append mode when the file key names a
+     * different file than the one currently open.
+     *
+     * @param file_name configuration file to load
+     * @retval true on success otherwise false
+     */
+    bool LoadConfigFile(const std::string& file_name);
+
+    /**
+     * Loads a configuration file and reloads it whenever it changes.
+     *
+     * @param file_name configuration file to watch
+     * @retval true if the initial load succeeded otherwise false
+     */
+    bool WatchConfigFile(const std::string& file_name);
+
+    /**
+     * Stops watching the configuration file.
+     */
+    void StopWatchingConfigFile();
+
+    /**
+     * Adds an output which gets every formatted entry, see LogSink_C.
+     *
+     * @param sink sink to add
+     */
+    void AddSink(std::shared_ptr<LogSink_C> sink);
+
+    /**
+     * Removes an output added by AddSink().
+     *
+     * @param sink sink to remove
+     */
+    void RemoveSink(const std::shared_ptr<LogSink_C>& sink);
+
+    /**
+     * Sends the entries of this process to a ring in POSIX shared memory,
+     * which supernova_log_collector drains into one file for all processes.
+     *
+     * Logging never waits for the collector, entries are dropped while the
+     * ring is full. Usually combined with a log type which does not write a
+     * file of its own.
+     *
+     * @param name name of the shared memory object
+     * @param capacity number of entries the ring holds if it is created
+     * @param slot_size bytes per entry if the ring is created
+     * @retval true on success otherwise false
+     */
+    bool EnableSharedMemoryLogging(
+        const std::string& name = kDefaultShmLogName, size_t capacity = 16384,
+        size_t slot_size = 512);
+
+    /**
+     * Sends the entries of this process in batches to a local collector,
+     * see SocketSink_C for the endpoint syntax.
+     *
+     * Connecting and sending happen on a thread of the sink, logging never
+     * waits for the collector.
+     *
+     * @param endpoint "unix:PATH", "tcp:HOST:PORT" or "udp:HOST:PORT"
+     * @param options batching and buffering settings
+     * @retval true if the endpoint is valid otherwise false
+     */
+    bool EnableSocketLogging(
+        const std::string& endpoint,
+        const SocketSinkOptions_TP& options = SocketSinkOptions_TP());
+
+    /**
+     * Writes the records of every thread to a file of that thread, named by
+     * ThreadFileName(), instead of to the other outputs. The logging thread
+     * formats and writes its records itself, without any lock or queue,
+     * also while asynchronous logging is enabled.
+     *
+     * Entries are stamped with their time and a sequence number, so
+     * supernova_log_merge can merge the files into one chronological log.
+     * A thread writes its file when its buffer is full, for records at the
+     * flush level and when it exits. FlushOut() writes the files of all
+     * threads, Sync() also syncs them to disk, and so does a FATAL record
+     * before the process aborts.
+     *
+     * @param base_name file name the thread ids are appended to
+     */
+    void EnablePerThreadFiles(const std::string& base_name);
+
+    /**
+     * Returns to the shared outputs. A thread writes and closes its file
+     * with FlushOut() or when it exits.
+     */
+    void DisablePerThreadFiles();
 
     /**
      * Sets the underlying stream to stream map corresponding to log level
@@ -276,25 +664,284 @@ class Logger_C {
     std::ostream& GetStream() { return m_str_stream; }
 
    private:
-    static Logger_C* m_instance;
+    /** Number of reader counters, each on a cache line of its own */
+    static constexpr size_t kConfigReaderShards = 8;
+
+    /**
+     * @struct ConfigReaders_TP
+     *
+     * @brief Threads reading a snapshot through ConfigReader_C.
+     *
+     */
+    struct alignas(64) ConfigReaders_TP {
+        std::atomic<uint32_t> m_count{0};
+    };
+
+    /**
+     * @struct RetiredConfig_TP
+     *
+     * @brief A replaced snapshot waiting to be reclaimed.
+     *
+     */
+    struct RetiredConfig_TP {
+        std::unique_ptr<const LogConfig_TP> m_config;
+        /** Reader counters not seen at zero since the snapshot was replaced,
+         * one bit per shard */
+        uint32_t m_busy_shards;
+    };
+
+    /** SN::Log::Logger_C::ConfigReader_C
+     *
+     * @b Description
+     * Registers the thread as reader of the current snapshot, which then
+     * is not reclaimed before the reader has gone, however long it takes,
+     * e.g. when the output blocks. Every read of a snapshot goes through
+     * a reader, so a replaced snapshot is freed as soon as its readers are
+     * gone.
+     *
+     * @b Rationale
+     * Counting readers costs two atomic operations on a counter shared by
+     * few threads, which is cheaper than a reference count per snapshot
+     * all threads would contend on.
+     */
+    class ConfigReader_C {
+       public:
+        explicit ConfigReader_C(const Logger_C& logger)
+            : m_count(logger.m_config_readers[ReaderShard()].m_count) {
+            // Sequentially consistent with the store in PublishConfig() and
+            // the load in ReclaimConfigs(), either the writer sees the count
+            // or the reader sees the new snapshot
+            m_count.fetch_add(1, std::memory_order_seq_cst);
+            m_config = logger.m_config.load(std::memory_order_seq_cst);
+        }
+
+        ~ConfigReader_C() { m_count.fetch_sub(1, std::memory_order_release); }
+
+        ConfigReader_C(const ConfigReader_C& rhs) = delete;
+        ConfigReader_C& operator=(const ConfigReader_C& rhs) = delete;
+
+        const LogConfig_TP& Get() const { return *m_config; }
+
+       private:
+        static size_t ReaderShard() {
+            static std::atomic<size_t> next_shard{0};
+            thread_local size_t shard =
+                next_shard.fetch_add(1, std::memory_order_relaxed) %
+                kConfigReaderShards;
+            return shard;
+        }
+
+        std::atomic<uint32_t>& m_count;
+        const LogConfig_TP* m_config;
+    };
+
+    /**
+     * Copies the current snapshot, applies a change and publishes the copy.
+     *
+     * @param update change to apply
+     */
+    template <typename Update>
+    void UpdateConfig(Update update) {
+        std::lock_guard<std::mutex> lock(m_config_mutex);
+        std::unique_ptr<LogConfig_TP> config(
+            new LogConfig_TP(*m_current_config));
+        update(*config);
+        PublishConfig(std::move(config));
+    }
+
+    /**
+     * Publishes a snapshot and retires the one it replaces, m_config_mutex
+     * must be held.
+     *
+     * @param config snapshot to publish
+     */
+    void PublishConfig(std::unique_ptr<LogConfig_TP> config);
+
+    /**
+     * Frees the retired snapshots which no reader can still use,
+     * m_config_mutex must be held.
+     */
+    void ReclaimConfigs();
+
+    /**
+     * Formats a record into an entry including the line break.
+     *
+     * @param config configuration to format with
+     * @param record record to format
+     * @param entry buffer to append to
+     */
+    static void FormatRecord(const LogConfig_TP& config,
+                             const LogRecord_TP& record, LogBuffer_C& entry);
+
+    /**
+     * Formats and writes a record on the calling thread.
+     *
+     * @param config configuration to format with
+     * @param record record to write
+     */
+    void WriteRecord(const LogConfig_TP& config, const LogRecord_TP& record);
+
+    /**
+     * Formats and writes a batch of records, called by the backend thread.
+     *
+     * @param batch records to write
+     */
+    void WriteBatchOut(std::vector<LogRecord_TP>& batch);
+
+    /**
+     * Formats records into batches and writes them with WriteEntries().
+     *
+     * @param config configuration to format with
+     * @param records records to write
+     * @param count number of records
+     * @param filter skip records the levels don't accept
+     */
+    void WriteRecords(const LogConfig_TP& config, const LogRecord_TP* records,
+                      size_t count, bool filter);
+
+    /**
+     * Writes a batch of formatted entries to the outputs.
+     *
+     * @param config configuration the entries were formatted with
+     * @param batch formatted entries
+     * @param flush flush the outputs afterwards
+     */
+    void WriteEntries(const LogConfig_TP& config,
+                      const LogEntryBatch_TP& batch, bool flush);
+
+    /**
+     * Writes a formatted entry to the outputs, m_write_mutex must be held.
+     *
+     * @param config configuration the entry was formatted with
+     * @param record record the entry was formatted from
+     * @param entry formatted entry including the line break
+     * @param size size of the entry
+     * @param flush flush the outputs if the flush level asks for it
+     */
+    void WriteOut(const LogConfig_TP& config, const LogRecord_TP& record,
+                  const char* entry, size_t size, bool flush = true);
+
+    /**
+     * Flushes the file, the console streams and the sinks, m_write_mutex
+     * must be held.
+     */
+    void FlushOutputs();
+
+    /**
+     * Closes the log file and opens another one together with the
+     * descriptor used to sync it, m_write_mutex must be held.
+     *
+     * @param file_name log file name
+     * @param mode open mode of the file stream
+     */
+    void OpenLogFile(const std::string& file_name,
+                     std::ios_base::openmode mode);
+
+    /**
+     * Writes a record to the file of the calling thread.
+     *
+     * @param config configuration to format the record with
+     * @param record record to write
+     * @param generation current value of m_thread_files
+     */
+    void WriteThreadFile(const LogConfig_TP& config,
+                         const LogRecord_TP& record, uint64_t generation);
+
+    /**
+     * Flushes the outputs and, with durable set, syncs the log file, the
+     * sinks and the per-thread files to disk. Takes m_write_mutex.
+     *
+     * @param durable true to sync to disk, false to flush only
+     * @retval true on success otherwise false
+     */
+    bool SyncOutputs(bool durable);
+
+    /**
+     * Flushes the files of all threads and, with durable set, syncs them to
+     * disk. Takes m_thread_file_mutex.
+     *
+     * @param durable true to sync to disk, false to flush only
+     * @retval true on success otherwise false
+     */
+    bool SyncThreadFiles(bool durable);
+
+    /**
+     * Logs a record which passed the level checks of Submit().
+     *
+     * @param config configuration snapshot the record was checked against
+     * @param record record to log
+     */
+    void SubmitAccepted(const LogConfig_TP& config, LogRecord_TP& record);
+
+    /**
+     * Creates the singleton once, GetInstance() only calls it while the
+     * instance is missing.
+     */
+    static Logger_C* CreateInstance();
+
+    static std::atomic<Logger_C*> m_instance;
     /** A map of default streams and corresponding terminal text color for each
      * log level */
     static LogStreamMap_TP m_stream_map;
 
-    LogSeverityLevel_TP m_log_severity_level;
-    LogSeverityLevel_TP m_active_log_level;
-    TimeStampMode_TP m_time_stamp_mode;
-    LogType_TP m_log_type;
+    /** Current configuration snapshot, read through ConfigReader_C */
+    std::atomic<const LogConfig_TP*> m_config;
+    /** The published snapshot, m_config points to it */
+    std::unique_ptr<const LogConfig_TP> m_current_config;
+    /** Replaced snapshots, see ReclaimConfigs() */
+    std::vector<RetiredConfig_TP> m_retired_configs;
+    mutable ConfigReaders_TP m_config_readers[kConfigReaderShards];
+    std::mutex m_config_mutex;  //!< serializes configuration writers
+    std::unique_ptr<LogConfigWatcher_C> m_config_watcher;
 
-    std::string m_log_file_name;
+    /** Serializes writing the outputs */
+    std::mutex m_write_mutex;
+    std::string m_open_file_name;
+    /** Descriptor of the open log file for syncing, -1 if there is none */
+    int m_file_fd;
+    std::vector<std::shared_ptr<LogSink_C>> m_sinks;
 
     std::ostringstream m_str_stream;
     std::ofstream m_file_stream;
 
-    std::string m_format;
+    /** Backend of asynchronous logging, null when logging synchronously */
+    std::atomic<LogBackend_C*> m_backend;
+    /** Every backend started so far. A stopped backend is kept, a thread may
+     * still be pushing into it and gets STOPPED back */
+    std::vector<std::unique_ptr<LogBackend_C>> m_backends;
+    std::mutex m_backend_mutex;  //!< serializes enabling and disabling
+    /** Raises the effective level under overload, driven by the backend */
+    LogLoadShedder_C m_shedder;
+
+    /** Generation of the per-thread file settings, zero while disabled. A
+     * thread reopens its file when the generation has changed */
+    std::atomic<uint64_t> m_thread_files;
+    uint64_t m_thread_files_generation;  //!< last generation handed out
+    std::string m_thread_file_base;      //!< base name of the thread files
+    /** Files of the threads writing per-thread files, for flushing */
+    std::vector<std::weak_ptr<LogThreadFile_C>> m_thread_file_registry;
+    std::mutex m_thread_file_mutex;  //!< guards the three above
 
 };  // end class Logger_C
 
+// Defined here rather than in log_message_sink.h, which logger.h includes,
+// so that the whole message path inlines into the logging code
+inline LogMessageShink_C::~LogMessageShink_C() {
+    if (m_profile != nullptr) {
+        StopProfile();
+    }
+    LogRecord_TP record;
+    record.m_level = m_log_severity_level;
+    record.m_file = m_file_name;
+    record.m_function = m_function_name;
+    record.m_line = m_line_number;
+    record.m_sample_rate = m_sample_rate;
+    record.m_message = m_buffer.View();
+    // The view stays valid, moving the buffer keeps its storage
+    record.m_buffer = std::move(m_buffer);
+    Logger_C::GetInstance()->Submit(record, m_site_checked);
+}
+
 }  // end namespace Log
 }  // end namespace SN
 
@@ -315,14 +962,31 @@ class Logger_C {
 #endif
 #endif
 
+/**
+ * Checks a severity level against the cached decision of the call site.
+ *
+ * @param level severity level to log at
+ */
+#define SN_LOG_SITE_ENABLED(level)                                  \
+    SN_LOG_SAMPLER_STATE(SN::Log::LogCallSite_C)                    \
+        .Enabled(level, __FILE__, __FUNCTION_NAME__, __LINE__)
+
 /**
  * General logging preprocessor Macro
  *
+ * A disabled site costs one load of its cached decision, the operands are
+ * not evaluated then.
+ *
  * @param level severity level to log at
  */
-#define SN_LOG(level)                                                        \
-    SN::Log::LogMessageShink_C(level, __FILE__, __FUNCTION_NAME__, __LINE__) \
-        .GetStream()
+#define SN_LOG(level)                                                     \
+    !SN_LOG_SITE_ENABLED(level)                                           \
+        ? static_cast<void>(0)                                            \
+        : SN::Log::LogMessageVoidify_C() &                                \
+              SN::Log::LogMessageShink_C(level, __FILE__,                 \
+                                         __FUNCTION_NAME__, __LINE__, 1,  \
+                                         true)                            \
+                  .GetStream()
 
 #define SN_LOG_TRACE SN_LOG(SN::Log::LogSeverityLevel_TP::LOG_TRACE)
 #define SN_LOG_DEBUG SN_LOG(SN::Log::LogSeverityLevel_TP::LOG_DEBUG)
@@ -331,6 +995,26 @@ class Logger_C {
 #define SN_LOG_ERROR SN_LOG(SN::Log::LogSeverityLevel_TP::LOG_ERROR)
 #define SN_LOG_FATAL SN_LOG(SN::Log::LogSeverityLevel_TP::LOG_FATAL)
 
+/**
+ * Binary data logging preprocessor Macros
+ *
+ * Encode the data straight into the message, in hexadecimal or base64, up
+ * to the limit set by Logger_C::SetBlobLimit(). More operands may follow,
+ * e.g. SN_LOG_HEX(level, frame.data, frame.len) << " id " << frame.id.
+ *
+ * @param level severity level to log at
+ * @param data pointer to the bytes
+ * @param size number of bytes
+ */
+#define SN_LOG_HEX(level, data, size)                           \
+    SN_LOG(level) << SN::Log::HexBytes(                         \
+        data, size,                                             \
+        SN::Log::Logger_C::GetInstance()->GetBlobLimit())
+#define SN_LOG_BASE64(level, data, size)                        \
+    SN_LOG(level) << SN::Log::Base64Bytes(                      \
+        data, size,                                             \
+        SN::Log::Logger_C::GetInstance()->GetBlobLimit())
+
 /**
  * Custom assert macro. It evaluates the expr, if it is true continue execution
  * otherwise, crash and print the error message.
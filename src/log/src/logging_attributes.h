@@ -25,10 +25,15 @@
 
 // Standard Includes
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
+
+#include "log_format_kernels.h"
 
 namespace SN {
 namespace Log {
@@ -49,42 +54,49 @@ enum class LogSeverityLevel_TP {
 };
 
 /**
- * Stream operator<< for the log severity level
+ * Name of the log severity level
  *
- * @param stream output stream
  * @param log_severity_level enum
- * 
- * @retval output stream
+ *
+ * @retval level name, "??" for an unknown level
  *
  */
-inline std::ostream& operator<<(std::ostream& stream,
-                                const LogSeverityLevel_TP& log_severity_level) {
+inline const char* ToString(LogSeverityLevel_TP log_severity_level) {
     switch (log_severity_level) {
         case LogSeverityLevel_TP::LOG_TRACE:
-            stream << "TRACE";
-            break;
+            return "TRACE";
         case LogSeverityLevel_TP::LOG_DEBUG:
-            stream << "DEBUG";
-            break;
+            return "DEBUG";
         case LogSeverityLevel_TP::LOG_INFO:
-            stream << "INFO";
-            break;
+            return "INFO";
         case LogSeverityLevel_TP::LOG_WARN:
-            stream << "WARN";
-            break;
+            return "WARN";
         case LogSeverityLevel_TP::LOG_ERROR:
-            stream << "ERROR";
-            break;
+            return "ERROR";
         case LogSeverityLevel_TP::LOG_FATAL:
-            stream << "FATAL";
-            break;
+            return "FATAL";
         default:
-            stream << "??";
-            std::cerr << "Unknown log level: " << log_severity_level
-                      << std::endl;
-            break;
+            return "??";
     }
-    return stream;
+}
+
+/**
+ * Stream operator<< for the log severity level
+ *
+ * @param stream output stream
+ * @param log_severity_level enum
+ * 
+ * @retval output stream
+ *
+ */
+inline std::ostream& operator<<(std::ostream& stream,
+                                const LogSeverityLevel_TP& log_severity_level) {
+    const char* name = ToString(log_severity_level);
+    if (name[0] == '?') {
+        std::cerr << "Unknown log level: "
+                  << static_cast<int>(log_severity_level) << std::endl;
+    }
+    return stream << name;
 }
 
 /**
@@ -101,54 +113,90 @@ enum class TimeStampMode_TP {
     DATE_TIME = 4             //!< Date and time in time stamp(4)
 };
 
+/** Size of a buffer large enough for any time stamp */
+constexpr size_t kTimeStampBufferSize = 32;
+
 /**
- * Stream operator<< for the time stamp mode
+ * Writes a time stamp into a character buffer.
  *
- * @param stream output stream
  * @param time_stamp_mode TimeStampMode_TP enum
- * 
- * @retval output stream
+ * @param epoch_ns time to write in nanoseconds since the epoch
+ * @param buffer output buffer of at least kTimeStampBufferSize characters
+ *
+ * @retval number of characters written
  *
  */
-inline std::ostream& operator<<(std::ostream& stream,
-                                const TimeStampMode_TP& time_stamp_mode) {
-    using std::chrono::duration_cast;
-    using std::chrono::system_clock;
-    std::string time_stamp_str;
+inline size_t FormatTimeStamp(TimeStampMode_TP time_stamp_mode,
+                              int64_t epoch_ns, char* buffer) {
+    int64_t count = 0;
     switch (time_stamp_mode) {
         case TimeStampMode_TP::NONE:
-            break;
+            return 0;
         case TimeStampMode_TP::EPOCH_SECONDS:
-            time_stamp_str =
-                std::to_string(duration_cast<std::chrono::seconds>(
-                                   system_clock::now().time_since_epoch())
-                                   .count());
+            count = epoch_ns / 1000000000;
             break;
         case TimeStampMode_TP::EPOCH_MILLI_SECONDS:
-            time_stamp_str =
-                std::to_string(duration_cast<std::chrono::milliseconds>(
-                                   system_clock::now().time_since_epoch())
-                                   .count());
+            count = epoch_ns / 1000000;
             break;
         case TimeStampMode_TP::EPOCH_MICRO_SECONDS:
-            time_stamp_str =
-                std::to_string(duration_cast<std::chrono::milliseconds>(
-                                   system_clock::now().time_since_epoch())
-                                   .count());
+            count = epoch_ns / 1000;
             break;
         case TimeStampMode_TP::DATE_TIME: {
-            auto now = system_clock::to_time_t(system_clock::now());
-            time_stamp_str = ctime(&now);
-            time_stamp_str.erase(time_stamp_str.length() - 1);
-            break;
+            time_t seconds = epoch_ns / 1000000000;
+#ifdef WIN32
+            ctime_s(buffer, kTimeStampBufferSize, &seconds);
+#else
+            ctime_r(&seconds, buffer);
+#endif
+            size_t length = std::strlen(buffer);
+            // Drop the trailing new line
+            if (length != 0 && buffer[length - 1] == '\n') {
+                --length;
+            }
+            return length;
         }
         default:
-            std::cerr << "Wrong time stamp mode: " << time_stamp_mode
-                      << std::endl;
-            break;
+            std::cerr << "Wrong time stamp mode: "
+                      << static_cast<int>(time_stamp_mode) << std::endl;
+            return 0;
     }
-    if (!time_stamp_str.empty()) {
-        stream << time_stamp_str;
+    return Kernels::FormatSigned(count, buffer);
+}
+
+/**
+ * Writes the current time stamp into a character buffer.
+ *
+ * @param time_stamp_mode TimeStampMode_TP enum
+ * @param buffer output buffer of at least kTimeStampBufferSize characters
+ *
+ * @retval number of characters written
+ *
+ */
+inline size_t FormatTimeStamp(TimeStampMode_TP time_stamp_mode, char* buffer) {
+    using std::chrono::duration_cast;
+    using std::chrono::system_clock;
+    return FormatTimeStamp(time_stamp_mode,
+                           duration_cast<std::chrono::nanoseconds>(
+                               system_clock::now().time_since_epoch())
+                               .count(),
+                           buffer);
+}
+
+/**
+ * Stream operator<< for the time stamp mode
+ *
+ * @param stream output stream
+ * @param time_stamp_mode TimeStampMode_TP enum
+ * 
+ * @retval output stream
+ *
+ */
+inline std::ostream& operator<<(std::ostream& stream,
+                                const TimeStampMode_TP& time_stamp_mode) {
+    char time_stamp[kTimeStampBufferSize];
+    size_t length = FormatTimeStamp(time_stamp_mode, time_stamp);
+    if (length != 0) {
+        stream.write(time_stamp, static_cast<std::streamsize>(length));
     }
     return stream;
 }
@@ -166,6 +214,121 @@ enum class LogType_TP {
     BOTH = 3          //!< Enable both console and file logs(3)
 };
 
+/**
+ * @enum OverflowPolicy_TP
+ *
+ * @brief What an asynchronous logger does when its queue is full.
+ *
+ */
+enum class OverflowPolicy_TP {
+    BLOCK = 0,            //!< Wait for room up to a timeout, then drop(0)
+    DROP_NEWEST = 1,      //!< Drop the message being logged(1)
+    /** Drop the oldest message of the lowest priority, or the message being
+     * logged when every queued one has a higher priority(2) */
+    DROP_OLDEST = 2,
+    DROP_BELOW_LEVEL = 3  //!< Drop messages below a level, queue others(3)
+};
+
+/**
+ * @struct OverflowSettings_TP
+ *
+ * @brief Overflow policy of an asynchronous logger.
+ *
+ */
+struct OverflowSettings_TP {
+    OverflowPolicy_TP m_policy;  //!< what to do when the queue is full
+    /** With DROP_BELOW_LEVEL: messages at this level or higher always get a
+     * slot, using the reserve of the queue */
+    LogSeverityLevel_TP m_level;
+    /** With BLOCK: longest wait for room before the message is dropped */
+    std::chrono::milliseconds m_block_timeout;
+};
+
+/**
+ * @struct LoadSheddingSettings_TP
+ *
+ * @brief When the asynchronous logger raises its effective level on its own.
+ *
+ * Pressure is high when the queue is filled up to m_high_occupancy or the
+ * output takes m_high_latency or longer per record. It is low when both are
+ * at or below the low marks, in between the current level is kept.
+ *
+ */
+struct LoadSheddingSettings_TP {
+    bool m_enabled = false;          //!< shedding is off by default
+    double m_high_occupancy = 0.75;  //!< share of the queue in use
+    double m_low_occupancy = 0.25;   //!< share of the queue in use
+    /** Average write time per record */
+    std::chrono::microseconds m_high_latency{200};
+    std::chrono::microseconds m_low_latency{50};  //!< see m_high_latency
+    /** Shortest time between two raises of the level */
+    std::chrono::milliseconds m_step{50};
+    /** How long pressure has to stay low before the level is lowered by one
+     * step */
+    std::chrono::milliseconds m_hold{1000};
+    /** Highest level shedding raises to, messages at this level or higher
+     * are never shed */
+    LogSeverityLevel_TP m_max_level = LogSeverityLevel_TP::LOG_WARN;
+};
+
+/**
+ * @enum BackendWaitStrategy_TP
+ *
+ * @brief How the backend thread of an asynchronous logger waits for records.
+ *
+ */
+enum class BackendWaitStrategy_TP {
+    BLOCK = 0,      //!< Sleep on a condition variable(0)
+    PARK = 1,       //!< Sleep on a futex, BLOCK where there is none(1)
+    SPIN = 2,       //!< Poll the queue without pause(2)
+    SPIN_YIELD = 3  //!< Poll for the spin time, then yield between polls(3)
+};
+
+/**
+ * @enum BackendSchedPolicy_TP
+ *
+ * @brief Scheduling policy of the backend thread.
+ *
+ */
+enum class BackendSchedPolicy_TP {
+    INHERIT = 0,  //!< Keep the policy of the thread that starts it(0)
+    OTHER = 1,    //!< SCHED_OTHER, the default time sharing policy(1)
+    FIFO = 2,     //!< SCHED_FIFO real time policy(2)
+    RR = 3,       //!< SCHED_RR real time policy(3)
+    BATCH = 4,    //!< SCHED_BATCH, for CPU bound work(4)
+    IDLE = 5      //!< SCHED_IDLE, runs only when nothing else wants to(5)
+};
+
+/**
+ * @struct BackendThreadSettings_TP
+ *
+ * @brief Placement and wait strategy of the backend thread of an
+ * asynchronous logger.
+ *
+ * SPIN hands a record over within microseconds but keeps a core busy, it
+ * is meant for a core of its own, e.g. one isolated with isolcpus. BLOCK and
+ * PARK sleep while the queue is empty, a wake threshold above one lets
+ * producers skip the wake up until a batch is worth writing. Records at
+ * ERROR or higher always wake the backend.
+ *
+ */
+struct BackendThreadSettings_TP {
+    /** Thread name shown by top and debuggers, at most 15 characters */
+    std::string m_name = "sn_log_backend";
+    std::vector<int> m_cpus;  //!< CPUs the thread may run on, empty for any
+    BackendSchedPolicy_TP m_policy = BackendSchedPolicy_TP::INHERIT;
+    /** Priority with FIFO and RR, 1 to 99 on Linux */
+    int m_priority = 0;
+    BackendWaitStrategy_TP m_wait = BackendWaitStrategy_TP::BLOCK;
+    /** With SPIN_YIELD: how long to poll before yielding */
+    std::chrono::microseconds m_spin_time{50};
+    /** With BLOCK and PARK: queued records which wake a sleeping backend */
+    size_t m_wake_threshold = 1;
+    /** With BLOCK and PARK: longest sleep while records below the wake
+     * threshold are queued */
+    std::chrono::microseconds m_max_park{1000};
+};
+
 /**
  * Typedef to store ostream corresponding to the log severity level
  *
@@ -0,0 +1,168 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file supernova_log_collector.cpp
+ *
+ * @brief Drains the shared memory log ring of all processes into one output.
+ *
+ * Processes call Logger_C::EnableSharedMemoryLogging() and the collector
+ * writes their entries in the order they were queued, prefixed with the
+ * process id. The collector can be started before or after the processes
+ * and restarted at any time, entries queued meanwhile stay in the ring as
+ * long as it has room.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "log/log_shm_ring.h"
+
+using namespace SN;
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void OnSignal(int) { g_stop = 1; }
+
+void PrintUsage(const char* program) {
+    std::cerr
+        << "Usage: " << program << " [options]\n"
+        << "  --name NAME       shared memory object (default "
+        << Log::kDefaultShmLogName << ")\n"
+        << "  --output FILE     output file, - for stdout (default -)\n"
+        << "  --capacity N      entries of a newly created ring (16384)\n"
+        << "  --slot-size N     bytes per entry of a newly created ring (512)\n"
+        << "  --stall-ms N      skip an entry left unfilled this long (1000)\n"
+        << "  --no-pid          don't prefix entries with the process id\n"
+        << "  --unlink          remove the ring on exit\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string name = Log::kDefaultShmLogName;
+    std::string output = "-";
+    size_t capacity = 16384;
+    size_t slot_size = 512;
+    long stall_ms = 1000;
+    bool print_pid = true;
+    bool unlink = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--name" && has_value) {
+            name = argv[++i];
+        } else if (arg == "--output" && has_value) {
+            output = argv[++i];
+        } else if (arg == "--capacity" && has_value) {
+            capacity = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--slot-size" && has_value) {
+            slot_size = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--stall-ms" && has_value) {
+            stall_ms = std::strtol(argv[++i], nullptr, 10);
+        } else if (arg == "--no-pid") {
+            print_pid = false;
+        } else if (arg == "--unlink") {
+            unlink = true;
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    std::string error;
+    std::unique_ptr<Log::ShmLogRing_C> ring =
+        Log::ShmLogRing_C::Open(name, capacity, slot_size, error);
+    if (!ring) {
+        std::cerr << "[ERROR] : " << error << std::endl;
+        return 1;
+    }
+    if (!ring->AttachConsumer(std::chrono::milliseconds(stall_ms))) {
+        std::cerr << "[ERROR] : Another collector is draining " << name
+                  << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (output != "-") {
+        file.open(output.c_str(), std::ofstream::out | std::ofstream::app);
+        if (!file.is_open()) {
+            std::cerr << "[ERROR] : Couldn't open file " << output
+                      << " for write." << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = output == "-" ? std::cout : file;
+
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    Log::ShmLogEntry_TP entry;
+    uint64_t reported_drops = ring->GetDroppedCount();
+    while (true) {
+        bool stopping = g_stop != 0;
+        size_t drained = 0;
+        while (ring->TryPop(entry)) {
+            if (print_pid) {
+                out << '[' << entry.m_pid << "] ";
+            }
+            out << entry.m_text;
+            if (entry.m_truncated) {
+                out << " [truncated]\n";
+            }
+            ++drained;
+        }
+        uint64_t drops = ring->GetDroppedCount();
+        if (drops != reported_drops) {
+            out << "[collector] " << drops - reported_drops
+                << " entries dropped\n";
+            reported_drops = drops;
+        }
+        if (drained != 0 || stopping) {
+            out.flush();
+        }
+        if (stopping) {
+            break;
+        }
+        if (drained == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    if (unlink) {
+        Log::ShmLogRing_C::Unlink(name);
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file supernova_log_merge.cpp
+ *
+ * @brief Merges the per-thread files of Logger_C::EnablePerThreadFiles()
+ * into one chronologically ordered log.
+ *
+ * Every file is memory mapped and the entries are merged through a heap
+ * keyed by their time stamps, so the merge reads each file once from front
+ * to back. Entries with the same time stamp keep the order of the files on
+ * the command line.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "log/log_thread_file.h"
+
+using namespace SN;
+
+namespace {
+
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] FILE...\n"
+              << "  --output FILE     output file, - for stdout (default -)\n"
+              << "  --stamps          keep the time stamp and sequence of "
+                 "every entry\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string output = "-";
+    bool keep_stamps = false;
+    std::vector<std::string> file_names;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--output" && has_value) {
+            output = argv[++i];
+        } else if (arg == "--stamps") {
+            keep_stamps = true;
+        } else if (!arg.empty() && arg[0] != '-') {
+            file_names.push_back(arg);
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    if (file_names.empty()) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    std::ofstream file;
+    if (output != "-") {
+        file.open(output.c_str(), std::ofstream::out | std::ofstream::binary);
+        if (!file.is_open()) {
+            std::cerr << "[ERROR] : Couldn't open file " << output
+                      << " for write." << std::endl;
+            return 1;
+        }
+    } else {
+        // The merge writes in large blocks of its own
+        std::ios_base::sync_with_stdio(false);
+    }
+    std::ostream& out = output == "-" ? std::cout : file;
+
+    std::string error;
+    uint64_t count = Log::MergeThreadFiles(file_names, out, keep_stamps, error);
+    if (!error.empty()) {
+        std::cerr << "[ERROR] : " << error;
+    }
+    if (!out.good()) {
+        std::cerr << "[ERROR] : Couldn't write " << output << std::endl;
+        return 1;
+    }
+    std::cerr << "[INFO] : Merged " << count << " entries from "
+              << file_names.size() << " files" << std::endl;
+    return error.empty() ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @file supernova_log_stats.cpp
+ *
+ * @brief Counts the entries of written log files per level, per log site
+ * and per time bucket.
+ *
+ * The files are memory mapped and split into chunks at line breaks, the
+ * chunks are parsed in parallel on every core. Entries are parsed back by
+ * the format string the logger wrote them with.
+ *
+ * @author Ajeet Singh Yadav
+ * Contact: er.ajeetsinghyadav@gmail.com
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "log/log_config.h"
+#include "log/log_stats.h"
+
+using namespace SN;
+
+namespace {
+
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] FILE...\n"
+              << "  --format FORMAT   format the logs were written with "
+                 "(default \"[%T] [%F:%C %P] [%L] :: %S\")\n"
+              << "  --timestamp MODE  time stamp mode, e.g. DATE_TIME or "
+                 "EPOCH_MILLI_SECONDS (default DATE_TIME)\n"
+              << "  --bucket SECONDS  width of a time bucket, 0 for none "
+                 "(default 60)\n"
+              << "  --rank LEVEL      rank sites by entries at this level or "
+                 "higher (default ERROR)\n"
+              << "  --top N           number of sites to list (default 20)\n"
+              << "  --threads N       parser threads (default one per "
+                 "core)\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string format = Log::LogConfig_TP().m_format.GetFormatString();
+    Log::TimeStampMode_TP time_stamp_mode = Log::TimeStampMode_TP::DATE_TIME;
+    long long bucket_seconds = 60;
+    Log::LogSeverityLevel_TP rank_level = Log::LogSeverityLevel_TP::LOG_ERROR;
+    unsigned long top = 20;
+    unsigned long threads = 0;
+    std::vector<std::string> file_names;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        bool ok = true;
+        if (arg == "--format" && has_value) {
+            format = argv[++i];
+        } else if (arg == "--timestamp" && has_value) {
+            ok = Log::ParseTimeStampMode(argv[++i], time_stamp_mode);
+        } else if (arg == "--bucket" && has_value) {
+            bucket_seconds = std::strtoll(argv[++i], nullptr, 10);
+        } else if (arg == "--rank" && has_value) {
+            ok = Log::ParseLogSeverityLevel(argv[++i], rank_level);
+        } else if (arg == "--top" && has_value) {
+            top = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && has_value) {
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (!arg.empty() && arg[0] != '-') {
+            file_names.push_back(arg);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            PrintUsage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    if (file_names.empty()) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    Log::LogStatsParser_C parser(format, time_stamp_mode, bucket_seconds);
+    Log::LogStats_TP stats;
+    std::string error;
+    bool ok = Log::CollectLogStats(file_names, parser,
+                                   static_cast<unsigned>(threads), stats,
+                                   error);
+    if (!error.empty()) {
+        std::cerr << "[ERROR] : " << error;
+    }
+    Log::WriteLogStats(stats, std::cout, rank_level, top);
+    std::cout.flush();
+    return ok ? 0 : 1;
+}
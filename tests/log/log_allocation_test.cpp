@@ -0,0 +1,308 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   MAY-2021
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * Allocation and syscall budgets of SN_LOG_INFO.
+ *
+ * The global operator new, and on glibc malloc, calloc and realloc, are
+ * replaced by counting versions. Counting is armed per thread, so only the
+ * allocations of the logging thread inside the measured window count. Write
+ * syscalls are read from the kernel's per thread I/O accounting.
+ */
+
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define SN_TEST_SANITIZED 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || \
+    __has_feature(memory_sanitizer)
+#define SN_TEST_SANITIZED 1
+#endif
+#endif
+
+// The sanitizers bring their own malloc, only operator new is replaced then
+#if defined(__GLIBC__) && !defined(SN_TEST_SANITIZED)
+#define SN_TEST_INTERPOSE_MALLOC 1
+#endif
+
+namespace {
+
+/** Set once a thread armed counting, keeps the thread local state untouched
+ * by allocations made while the runtime starts up */
+std::atomic<bool> g_counting{false};
+thread_local bool t_counting = false;
+thread_local int64_t t_allocations = 0;
+
+inline void CountAllocation() {
+    if (g_counting.load(std::memory_order_relaxed) && t_counting) {
+        ++t_allocations;
+    }
+}
+
+}  // namespace
+
+#ifdef SN_TEST_INTERPOSE_MALLOC
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+    CountAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    CountAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    CountAllocation();
+    return __libc_realloc(ptr, size);
+}
+}
+
+namespace {
+/** Allocates without counting, operator new counts itself */
+inline void* RawAllocate(size_t size) { return __libc_malloc(size); }
+}  // namespace
+#else
+namespace {
+inline void* RawAllocate(size_t size) { return std::malloc(size); }
+}  // namespace
+#endif
+
+namespace {
+/** Out of line, GCC would flag free() on memory of operator new otherwise */
+__attribute__((noinline)) void RawFree(void* ptr) { std::free(ptr); }
+}  // namespace
+
+void* operator new(size_t size) {
+    CountAllocation();
+    void* ptr = RawAllocate(size == 0 ? 1 : size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    CountAllocation();
+    return RawAllocate(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept { RawFree(ptr); }
+void operator delete[](void* ptr) noexcept { RawFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { RawFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { RawFree(ptr); }
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+constexpr int kMessages = 100;
+
+/** Reads the write syscalls of the calling thread, -1 if unknown */
+int64_t WriteSyscalls() {
+#if defined(__linux__)
+    int fd = open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    char text[512];
+    ssize_t size = read(fd, text, sizeof(text) - 1);
+    close(fd);
+    if (size <= 0) {
+        return -1;
+    }
+    text[size] = '\0';
+    const char* field = std::strstr(text, "syscw: ");
+    return field ? std::strtoll(field + 7, nullptr, 10) : -1;
+#else
+    return -1;
+#endif
+}
+
+/** Counts the allocations and write syscalls of the calling thread while
+ * alive */
+class AllocationCounter_C {
+   public:
+    AllocationCounter_C() : m_syscalls(WriteSyscalls()) {
+        t_allocations = 0;
+        t_counting = true;
+        g_counting.store(true, std::memory_order_relaxed);
+    }
+
+    ~AllocationCounter_C() { Stop(); }
+
+    void Stop() {
+        if (t_counting) {
+            t_counting = false;
+            m_allocations = t_allocations;
+            int64_t syscalls = WriteSyscalls();
+            m_syscalls = m_syscalls < 0 || syscalls < 0
+                             ? -1
+                             : syscalls - m_syscalls;
+        }
+    }
+
+    int64_t Allocations() const { return m_allocations; }
+    /** Write syscalls, -1 when the kernel doesn't account them */
+    int64_t Syscalls() const { return m_syscalls; }
+
+   private:
+    int64_t m_allocations = 0;
+    int64_t m_syscalls;
+};
+
+/** Logs to a file of its own and restores the logger afterwards */
+class LogAllocation_Test : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        m_logger = Log::Logger_C::GetInstance();
+        m_saved = m_logger->GetConfig();
+        m_logger->SetLogType(Log::LogType_TP::FILE_LOG);
+        m_logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+        m_logger->SetFlushLevel(Log::LogSeverityLevel_TP::LOG_TRACE);
+        m_logger->SetFormat("[%T] [%F:%C %P] [%L] :: %S");
+        m_logger->ClearSiteRules();
+        m_logger->Init(kFileName);
+        m_logger->Prepare();
+    }
+
+    void TearDown() override {
+        m_logger->DisableAsyncLogging();
+        m_logger->SetConfig(m_saved);
+        std::remove(kFileName);
+    }
+
+    /** Logs the message every budget is measured with */
+    static void LogMessages(int count) {
+        for (int i = 0; i < count; ++i) {
+            SN_LOG_INFO << "request " << i << " took " << i * 0.25 << " ms";
+        }
+    }
+
+    static size_t CountLines() {
+        std::ifstream file(kFileName);
+        std::string line;
+        size_t lines = 0;
+        while (std::getline(file, line)) {
+            ++lines;
+        }
+        return lines;
+    }
+
+    static constexpr const char* kFileName = "log_allocation_test.txt";
+    Log::Logger_C* m_logger = nullptr;
+    Log::LogConfig_TP m_saved;
+};
+
+}  // namespace
+
+TEST_F(LogAllocation_Test, CountsAllocations) {
+    AllocationCounter_C counter;
+    // Unlike new expressions, these calls may not be optimized away
+    ::operator delete(::operator new(sizeof(int)));
+    std::string text(64, 'x');
+    const char* volatile data = text.data();
+    (void)data;
+    counter.Stop();
+    EXPECT_EQ(2, counter.Allocations());
+}
+
+TEST_F(LogAllocation_Test, SyncMessageInEveryTimeStampMode) {
+    const Log::TimeStampMode_TP modes[] = {
+        Log::TimeStampMode_TP::NONE, Log::TimeStampMode_TP::EPOCH_SECONDS,
+        Log::TimeStampMode_TP::EPOCH_MILLI_SECONDS,
+        Log::TimeStampMode_TP::EPOCH_MICRO_SECONDS,
+        Log::TimeStampMode_TP::DATE_TIME};
+    for (Log::TimeStampMode_TP mode : modes) {
+        m_logger->SetTimeStampMode(mode);
+        LogMessages(8);
+        AllocationCounter_C counter;
+        LogMessages(kMessages);
+        counter.Stop();
+        EXPECT_EQ(0, counter.Allocations()) << static_cast<int>(mode);
+        if (counter.Syscalls() >= 0) {
+            // Flushed at every message, one write each
+            EXPECT_EQ(kMessages, counter.Syscalls()) << static_cast<int>(mode);
+        }
+    }
+    EXPECT_EQ(5u * (8 + kMessages), CountLines());
+}
+
+TEST_F(LogAllocation_Test, DisabledLevelCostsNothing) {
+    m_logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_WARN);
+    LogMessages(8);
+    AllocationCounter_C counter;
+    LogMessages(kMessages);
+    counter.Stop();
+    EXPECT_EQ(0, counter.Allocations());
+    EXPECT_LE(counter.Syscalls(), 0);
+    EXPECT_EQ(0u, CountLines());
+}
+
+TEST_F(LogAllocation_Test, AsyncMessageStaysOffTheCaller) {
+    m_logger->EnableAsyncLogging(4 * kMessages);
+    // Every queued record holds a slab until the backend released it, the
+    // caller needs enough of them for the whole burst
+    m_logger->PrepareThread(2 * kMessages);
+    LogMessages(8);
+    m_logger->FlushOut();
+    AllocationCounter_C counter;
+    LogMessages(kMessages);
+    counter.Stop();
+    m_logger->FlushOut();
+    EXPECT_EQ(0, counter.Allocations());
+    // Written by the backend thread
+    EXPECT_LE(counter.Syscalls(), 0);
+    EXPECT_EQ(8u + kMessages, CountLines());
+}
+
+}  // namespace Log_Test
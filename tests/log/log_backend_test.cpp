@@ -0,0 +1,447 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_backend.h"
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+/** Collects the written messages and holds the backend thread in its first
+ * batch until released, so the queue can be filled up deterministically */
+class StalledWriter_C {
+   public:
+    Log::LogBackend_C::WriteBatch_TP Callback() {
+        return [this](std::vector<Log::LogRecord_TP>& batch) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_started = true;
+            m_changed.notify_all();
+            m_changed.wait(lock, [this] { return m_released; });
+            for (const Log::LogRecord_TP& record : batch) {
+                m_messages.emplace_back(record.m_message);
+            }
+        };
+    }
+
+    void WaitStarted() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] { return m_started; });
+    }
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_released = true;
+        m_changed.notify_all();
+    }
+
+    std::vector<std::string> m_messages;
+
+   private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_started = false;
+    bool m_released = false;
+};
+
+Log::PushResult_TP Push(Log::LogBackend_C& backend,
+                        Log::LogSeverityLevel_TP level,
+                        const std::string& message,
+                        const Log::OverflowSettings_TP& overflow) {
+    Log::LogRecord_TP record;
+    record.m_level = level;
+    record.m_message = message;
+    record.OwnPayload();
+    return backend.Push(record, overflow);
+}
+
+const Log::LogSeverityLevel_TP kTrace = Log::LogSeverityLevel_TP::LOG_TRACE;
+const Log::LogSeverityLevel_TP kInfo = Log::LogSeverityLevel_TP::LOG_INFO;
+const Log::LogSeverityLevel_TP kError = Log::LogSeverityLevel_TP::LOG_ERROR;
+
+}  // namespace
+
+TEST(LogBackend_Test, DropNewestKeepsQueuedRecords) {
+    StalledWriter_C writer;
+    Log::LogBackend_C backend(4, writer.Callback());
+    Log::OverflowSettings_TP overflow{Log::OverflowPolicy_TP::DROP_NEWEST,
+                                      kError, std::chrono::milliseconds(0)};
+    EXPECT_EQ(Log::PushResult_TP::QUEUED, Push(backend, kInfo, "0", overflow));
+    writer.WaitStarted();
+    for (int i = 1; i <= 7; ++i) {
+        Push(backend, kInfo, std::to_string(i), overflow);
+    }
+    EXPECT_EQ(3u, backend.GetDroppedCount(kInfo));
+    writer.Release();
+    backend.Stop();
+
+    ASSERT_EQ(6u, writer.m_messages.size());
+    EXPECT_EQ("4", writer.m_messages[4]);
+    EXPECT_EQ("Dropped 3 log records under overload (INFO: 3)",
+              writer.m_messages[5]);
+}
+
+TEST(LogBackend_Test, DropOldestKeepsNewestRecords) {
+    StalledWriter_C writer;
+    Log::LogBackend_C backend(2, writer.Callback());
+    Log::OverflowSettings_TP overflow{Log::OverflowPolicy_TP::DROP_OLDEST,
+                                      kError, std::chrono::milliseconds(0)};
+    Push(backend, kInfo, "0", overflow);
+    writer.WaitStarted();
+    Push(backend, kInfo, "1", overflow);
+    Push(backend, kInfo, "2", overflow);
+    Push(backend, kInfo, "3", overflow);
+    EXPECT_EQ(1u, backend.GetDroppedCount(kInfo));
+    writer.Release();
+    backend.Flush();
+    backend.Stop();
+
+    ASSERT_EQ(4u, writer.m_messages.size());
+    EXPECT_EQ("2", writer.m_messages[1]);
+    EXPECT_EQ("3", writer.m_messages[2]);
+}
+
+TEST(LogBackend_Test, DropOldestSparesHigherLanes) {
+    StalledWriter_C writer;
+    Log::LogBackend_C backend(2, writer.Callback());
+    Log::OverflowSettings_TP overflow{Log::OverflowPolicy_TP::DROP_OLDEST,
+                                      kError, std::chrono::milliseconds(0)};
+    Push(backend, kInfo, "0", overflow);
+    writer.WaitStarted();
+    // The queued error is older, yet the INFO record goes
+    Push(backend, kError, "1", overflow);
+    Push(backend, kInfo, "2", overflow);
+    Push(backend, kInfo, "3", overflow);
+    EXPECT_EQ(0u, backend.GetDroppedCount(kError));
+    EXPECT_EQ(1u, backend.GetDroppedCount(kInfo));
+    writer.Release();
+    backend.Flush();
+    backend.Stop();
+
+    ASSERT_EQ(4u, writer.m_messages.size());
+    EXPECT_EQ("1", writer.m_messages[1]);
+    EXPECT_EQ("3", writer.m_messages[2]);
+}
+
+TEST(LogBackend_Test, DropOldestDropsIncomingLowerRecord) {
+    StalledWriter_C writer;
+    Log::LogBackend_C backend(2, writer.Callback());
+    Log::OverflowSettings_TP overflow{Log::OverflowPolicy_TP::DROP_OLDEST,
+                                      kError, std::chrono::milliseconds(0)};
+    Push(backend, kError, "0", overflow);
+    writer.WaitStarted();
+    Push(backend, kError, "1", overflow);
+    Push(backend, kError, "2", overflow);
+    // Only errors are queued, the INFO record goes instead of one of them
+    EXPECT_EQ(Log::PushResult_TP::DROPPED,
+              Push(backend, kInfo, "3", overflow));
+    EXPECT_EQ(0u, backend.GetDroppedCount(kError));
+    EXPECT_EQ(1u, backend.GetDroppedCount(kInfo));
+    writer.Release();
+    backend.Flush();
+    backend.Stop();
+
+    ASSERT_EQ(4u, writer.m_messages.size());
+    EXPECT_EQ("1", writer.m_messages[1]);
+    EXPECT_EQ("2", writer.m_messages[2]);
+    EXPECT_EQ("Dropped 1 log records under overload (INFO: 1)",
+              writer.m_messages[3]);
+}
+
+TEST(LogBackend_Test, DropBelowLevelReservesRoomForErrors) {
+    StalledWriter_C writer;
+    Log::LogBackend_C backend(8, writer.Callback());
+    Log::OverflowSettings_TP overflow{
+        Log::OverflowPolicy_TP::DROP_BELOW_LEVEL, kError,
+        std::chrono::milliseconds(0)};
+    Push(backend, kInfo, "first", overflow);
+    writer.WaitStarted();
+    for (int i = 0; i < 8; ++i) {
+        Push(backend, kInfo, "info", overflow);
+    }
+    EXPECT_EQ(Log::PushResult_TP::DROPPED,
+              Push(backend, kInfo, "info", overflow));
+    EXPECT_EQ(Log::PushResult_TP::QUEUED,
+              Push(backend, kError, "error", overflow));
+    writer.Release();
+    backend.Stop();
+
+    EXPECT_EQ(1u, backend.GetDroppedCount(kInfo));
+    ASSERT_EQ(11u, writer.m_messages.size());
+    // The error lane is drained ahead of the queued infos
+    EXPECT_EQ("error", writer.m_messages[1]);
+    EXPECT_EQ("info", writer.m_messages[2]);
+}
+
+TEST(LogBackend_Test, SyncWaitsForEarlierRecordsOnly) {
+    StalledWriter_C writer;
+    std::vector<size_t> synced;
+    Log::LogBackend_C backend(8, writer.Callback(),
+                              [&writer, &synced](bool durable) {
+                                  EXPECT_TRUE(durable);
+                                  synced.push_back(writer.m_messages.size());
+                                  return true;
+                              });
+    Log::OverflowSettings_TP overflow{Log::OverflowPolicy_TP::BLOCK, kError,
+                                      std::chrono::milliseconds(1000)};
+    Push(backend, kInfo, "0", overflow);
+    writer.WaitStarted();
+    Push(backend, kInfo, "1", overflow);
+    std::future<bool> first = backend.RequestSync(true);
+    std::future<bool> second = backend.RequestSync(true);
+    // Logging carries on behind the barriers
+    Push(backend, kInfo, "2", overflow);
+    EXPECT_EQ(std::future_status::timeout,
+              first.wait_for(std::chrono::milliseconds(20)));
+    writer.Release();
+    EXPECT_TRUE(first.get());
+    EXPECT_TRUE(second.get());
+    backend.Stop();
+
+    // One sync for both, after "1" and possibly "2" had been written
+    ASSERT_EQ(1u, synced.size());
+    EXPECT_GE(synced[0], 2u);
+    EXPECT_FALSE(backend.RequestSync(true).get());
+}
+
+TEST(LogBackend_Test, ErrorsOvertakeQueuedTrace) {
+    StalledWriter_C writer;
+    Log::LogBackend_C backend(1024, writer.Callback());
+    Log::OverflowSettings_TP overflow{Log::OverflowPolicy_TP::DROP_NEWEST,
+                                      kError, std::chrono::milliseconds(0)};
+    Push(backend, kTrace, "first", overflow);
+    writer.WaitStarted();
+    for (int i = 0; i < 1000; ++i) {
+        Push(backend, kTrace, "trace " + std::to_string(i), overflow);
+    }
+    Push(backend, kInfo, "info", overflow);
+    Push(backend, kError, "error 0", overflow);
+    Push(backend, kError, "error 1", overflow);
+    writer.Release();
+    backend.Flush();
+    backend.Stop();
+
+    ASSERT_EQ(1004u, writer.m_messages.size());
+    EXPECT_EQ("error 0", writer.m_messages[1]);
+    EXPECT_EQ("error 1", writer.m_messages[2]);
+    EXPECT_EQ("info", writer.m_messages[3]);
+    // Within a lane the order is kept
+    for (size_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ("trace " + std::to_string(i), writer.m_messages[4 + i]);
+    }
+}
+
+TEST(LogBackend_Test, ErrorLatencyUnderTraceFlood) {
+    using Clock_TP = std::chrono::steady_clock;
+    constexpr size_t kCapacity = 8192;
+    constexpr auto kCostPerRecord = std::chrono::microseconds(10);
+    constexpr size_t kErrors = 20;
+
+    // Writes take a fixed time per record, so a full queue takes about
+    // 80 ms to drain
+    std::mutex mutex;
+    std::vector<Clock_TP::time_point> pushed(kErrors);
+    std::vector<Clock_TP::duration> latencies;
+    Log::LogBackend_C backend(
+        kCapacity, [&](std::vector<Log::LogRecord_TP>& batch) {
+            std::this_thread::sleep_for(kCostPerRecord *
+                                        static_cast<int>(batch.size()));
+            auto now = Clock_TP::now();
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const Log::LogRecord_TP& record : batch) {
+                if (record.m_level == kError) {
+                    latencies.push_back(now - pushed[record.m_line]);
+                }
+            }
+        });
+    // The flood keeps the queue full, errors go to the reserve
+    Log::OverflowSettings_TP overflow{
+        Log::OverflowPolicy_TP::DROP_BELOW_LEVEL, kError,
+        std::chrono::milliseconds(0)};
+
+    std::atomic<bool> stop(false);
+    std::thread flood([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            Push(backend, kTrace, "flood", overflow);
+        }
+    });
+    // Let the flood fill the queue
+    while (backend.GetDroppedCount(kTrace) == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (size_t i = 0; i < kErrors; ++i) {
+        Log::LogRecord_TP record;
+        record.m_level = kError;
+        record.m_line = static_cast<uint32_t>(i);
+        record.m_message = "error";
+        record.OwnPayload();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pushed[i] = Clock_TP::now();
+        }
+        EXPECT_EQ(Log::PushResult_TP::QUEUED, backend.Push(record, overflow));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    stop = true;
+    flood.join();
+    backend.Stop();
+
+    ASSERT_EQ(kErrors, latencies.size());
+    Clock_TP::duration worst = *std::max_element(latencies.begin(),
+                                                 latencies.end());
+    ::testing::Test::RecordProperty(
+        "worst_error_latency_us",
+        static_cast<int>(
+            std::chrono::duration_cast<std::chrono::microseconds>(worst)
+                .count()));
+    // One batch of trace ahead takes about 2.5 ms, the queue ahead 80 ms
+    EXPECT_LT(worst, kCostPerRecord * static_cast<int>(kCapacity) / 4);
+}
+
+TEST(LogBackend_Test, WaitStrategiesDeliverEveryRecord) {
+    const Log::BackendWaitStrategy_TP kStrategies[] = {
+        Log::BackendWaitStrategy_TP::BLOCK, Log::BackendWaitStrategy_TP::PARK,
+        Log::BackendWaitStrategy_TP::SPIN,
+        Log::BackendWaitStrategy_TP::SPIN_YIELD};
+    const Log::OverflowSettings_TP overflow{
+        Log::OverflowPolicy_TP::BLOCK, kInfo, std::chrono::milliseconds(1000)};
+    for (Log::BackendWaitStrategy_TP strategy : kStrategies) {
+        SCOPED_TRACE(static_cast<int>(strategy));
+        Log::BackendThreadSettings_TP settings;
+        settings.m_wait = strategy;
+        settings.m_wake_threshold = 8;
+        settings.m_max_park = std::chrono::microseconds(200);
+        std::atomic<size_t> written(0);
+        Log::LogBackend_C backend(
+            64,
+            [&written](std::vector<Log::LogRecord_TP>& batch) {
+                written += batch.size();
+            },
+            Log::LogBackend_C::SyncOutputs_TP(), settings);
+
+        // A lone record below the threshold is written after the park time
+        Push(backend, kInfo, "lone", overflow);
+        auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (written == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        EXPECT_EQ(1u, written.load());
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 2; ++t) {
+            producers.emplace_back([&backend, &overflow] {
+                for (int i = 0; i < 100; ++i) {
+                    Push(backend, kInfo, "record", overflow);
+                    if (i % 10 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        backend.Flush();
+        EXPECT_EQ(201u, written.load());
+        EXPECT_TRUE(backend.RequestSync(false).get());
+        backend.Stop();
+    }
+}
+
+#if defined(__linux__)
+TEST(LogBackend_Test, BackendThreadIsNamedAndPinned) {
+    Log::BackendThreadSettings_TP settings;
+    settings.m_name = "sn_log_test";
+    settings.m_cpus = {0};
+    std::string name;
+    bool pinned = false;
+    Log::LogBackend_C backend(
+        8,
+        [&name, &pinned](std::vector<Log::LogRecord_TP>& batch) {
+            if (batch.empty()) {
+                return;
+            }
+            char buffer[16] = {0};
+            pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+            name = buffer;
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            pinned = CPU_COUNT(&cpus) == 1 && CPU_ISSET(0, &cpus);
+        },
+        Log::LogBackend_C::SyncOutputs_TP(), settings);
+    Push(backend, kInfo, "record",
+         {Log::OverflowPolicy_TP::BLOCK, kInfo,
+          std::chrono::milliseconds(1000)});
+    backend.Flush();
+    backend.Stop();
+    EXPECT_EQ("sn_log_test", name);
+    EXPECT_TRUE(pinned);
+}
+#endif
+
+TEST(LogBackend_Test, LoggerWritesThroughBackend) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogType_TP log_type = logger->GetConfig().m_log_type;
+    std::string format = logger->GetFormat();
+    std::ostringstream stream;
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->SetFormat("%L %S");
+
+    logger->EnableAsyncLogging(16);
+    EXPECT_TRUE(logger->IsAsyncLogging());
+    for (int i = 0; i < 3; ++i) {
+        SN_LOG_WARN << "async " << i;
+    }
+    logger->FlushOut();
+    EXPECT_EQ("WARN async 0\nWARN async 1\nWARN async 2\n", stream.str());
+    logger->DisableAsyncLogging();
+    EXPECT_FALSE(logger->IsAsyncLogging());
+
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, std::cerr);
+    logger->SetFormat(format);
+    logger->SetLogType(log_type);
+}
+
+}  // namespace Log_Test
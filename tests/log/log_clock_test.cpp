@@ -0,0 +1,79 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_clock.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+int64_t SystemNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
+TEST(LogClock_Test, RawSourcesFollowWallTime) {
+    Log::LogClock_C* clock = Log::LogClock_C::GetInstance();
+    Log::ClockSource_TP source = clock->GetSource();
+    for (Log::ClockSource_TP raw :
+         {Log::ClockSource_TP::MONOTONIC_RAW, Log::ClockSource_TP::TSC}) {
+        clock->SetSource(raw);
+        int64_t before = SystemNs();
+        int64_t stamped = clock->Now().ToEpochNs();
+        int64_t after = SystemNs();
+        // Allow for the error of a 20ms calibration
+        EXPECT_LT(std::llabs(stamped - (before + after) / 2), 5000000);
+    }
+    clock->SetSource(source);
+}
+
+TEST(LogClock_Test, QueuedTimePointsSurviveRecalibration) {
+    Log::LogClock_C* clock = Log::LogClock_C::GetInstance();
+    Log::LogTimePoint_TP time_point = clock->Now();
+    int64_t epoch_ns = time_point.ToEpochNs();
+    clock->Calibrate(1);
+    EXPECT_EQ(epoch_ns, time_point.ToEpochNs());
+}
+
+TEST(LogClock_Test, ExternalSourceReadsApplicationTime) {
+    Log::LogClock_C* clock = Log::LogClock_C::GetInstance();
+    Log::ClockSource_TP source = clock->GetSource();
+    clock->SetSource(Log::ClockSource_TP::EXTERNAL);
+    clock->SetExternalTime(42000000000);
+    Log::LogTimePoint_TP time_point = clock->Now();
+    clock->SetExternalTime(43000000000);
+    EXPECT_EQ(42000000000, time_point.ToEpochNs());
+    EXPECT_EQ(43000000000, clock->Now().ToEpochNs());
+    clock->SetSource(source);
+}
+
+}  // namespace Log_Test
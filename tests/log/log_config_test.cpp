@@ -0,0 +1,167 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace SN;
+
+namespace Log_Test {
+TEST(LogConfig_Test, ParsesAllKeys) {
+    Log::LogConfig_TP config;
+    std::string error;
+    ASSERT_TRUE(Log::ParseLogConfig(
+        "# logger settings\n"
+        "level = WARN\n"
+        "level.physics = DEBUG\n"
+        "format = [%L] %S\n"
+        "timestamp = EPOCH_SECONDS\n"
+        "type = CONSOLE\n"
+        "file = other.txt\n"
+        "flush_level = ERROR\n"
+        "blob_limit = 64\n"
+        "load_shedding = on\n"
+        "shed_max_level = ERROR\n",
+        config, error))
+        << error;
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_WARN, config.m_log_severity_level);
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_DEBUG, config.m_gate_level);
+    EXPECT_EQ("[%L] %S", config.m_format.GetFormatString());
+    EXPECT_EQ(Log::TimeStampMode_TP::EPOCH_SECONDS, config.m_time_stamp_mode);
+    EXPECT_EQ(Log::LogType_TP::CONSOLE_LOG, config.m_log_type);
+    EXPECT_EQ("other.txt", config.m_log_file_name);
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_ERROR, config.m_flush_level);
+    EXPECT_EQ(64u, config.m_blob_limit);
+    EXPECT_TRUE(config.m_load_shedding.m_enabled);
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_ERROR,
+              config.m_load_shedding.m_max_level);
+
+    EXPECT_TRUE(config.Accepts(Log::LogSeverityLevel_TP::LOG_DEBUG,
+                               "src/physics/step.cpp"));
+    EXPECT_FALSE(config.Accepts(Log::LogSeverityLevel_TP::LOG_DEBUG,
+                                "src/render/physics_view.cpp"));
+}
+
+TEST(LogConfig_Test, ParsesSiteRules) {
+    Log::LogConfig_TP config;
+    std::string error;
+    ASSERT_TRUE(Log::ParseLogConfig(
+        "level = INFO\n"
+        "site.net/*.cpp@Reconnect = DEBUG\n"
+        "site.step.cpp:100-180 = TRACE\n"
+        "site.step.cpp:150 = OFF\n",
+        config, error))
+        << error;
+    ASSERT_EQ(3u, config.m_site_rules.size());
+    EXPECT_EQ("net/*.cpp", config.m_site_rules[0].m_file_glob);
+    EXPECT_EQ("Reconnect", config.m_site_rules[0].m_function);
+    EXPECT_EQ(100u, config.m_site_rules[1].m_first_line);
+    EXPECT_EQ(180u, config.m_site_rules[1].m_last_line);
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_TRACE, config.m_gate_level);
+
+    using Level = Log::LogSeverityLevel_TP;
+    EXPECT_EQ(Level::LOG_DEBUG,
+              config.MinimumLevel("/src/net/socket.cpp", "Reconnect", 10));
+    EXPECT_EQ(Level::LOG_INFO,
+              config.MinimumLevel("/src/net/socket.cpp", "Send", 10));
+    EXPECT_EQ(Level::LOG_INFO,
+              config.MinimumLevel("/src/internet/a.cpp", "Reconnect", 10));
+    EXPECT_EQ(Level::LOG_TRACE, config.MinimumLevel("src/step.cpp", "f", 100));
+    EXPECT_EQ(Level::LOG_INFO, config.MinimumLevel("src/step.cpp", "f", 99));
+    // The later rule wins
+    EXPECT_EQ(Level::LOG_FATAL, config.MinimumLevel("src/step.cpp", "f", 150));
+
+    EXPECT_TRUE(Log::GlobMatch("*.c?p", "a/b.cpp"));
+    EXPECT_FALSE(Log::GlobMatch("*.c?p", "a/b.cc"));
+    EXPECT_FALSE(Log::ParseLogConfig("site.a.cpp:x = DEBUG\n", config, error));
+    EXPECT_FALSE(
+        Log::ParseLogConfig("site.a.cpp:9-3 = DEBUG\n", config, error));
+}
+
+TEST(LogConfig_Test, RejectsInvalidConfig) {
+    Log::LogConfig_TP config;
+    std::string error;
+    EXPECT_FALSE(Log::ParseLogConfig("level = LOUD\n", config, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_FALSE(Log::ParseLogConfig("colour = red\n", config, error));
+}
+
+TEST(LogConfig_Test, CompilesFormat) {
+    Log::LogFormat_C format("[%L] %% %S%");
+    const auto& ops = format.GetOps();
+    ASSERT_EQ(size_t{5}, ops.size());
+    EXPECT_EQ("[", ops[0].m_literal);
+    EXPECT_EQ(Log::FormatOpKind_TP::LEVEL, ops[1].m_kind);
+    EXPECT_EQ("] % ", ops[2].m_literal);
+    EXPECT_EQ(Log::FormatOpKind_TP::MESSAGE, ops[3].m_kind);
+    EXPECT_EQ("%", ops[4].m_literal);
+}
+
+TEST(LogConfig_Test, ReloadsWatchedFile) {
+    const char* file_name = "log_config_test.cfg";
+    {
+        std::ofstream file(file_name);
+        file << "level = ERROR\n";
+    }
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogSeverityLevel_TP previous = logger->GetLogSeverityLevel();
+    ASSERT_TRUE(logger->WatchConfigFile(file_name));
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_ERROR,
+              logger->GetLogSeverityLevel());
+    {
+        std::ofstream file(file_name);
+        file << "level = DEBUG\n";
+    }
+    for (int i = 0; i < 100 && logger->GetLogSeverityLevel() !=
+                                   Log::LogSeverityLevel_TP::LOG_DEBUG;
+         ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_DEBUG,
+              logger->GetLogSeverityLevel());
+    logger->StopWatchingConfigFile();
+    logger->SetLogSeverityLevel(previous);
+    std::remove(file_name);
+}
+
+TEST(LogConfig_Test, ReclaimsRetiredSnapshots) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogSeverityLevel_TP previous = logger->GetLogSeverityLevel();
+    for (int i = 0; i < 1000; ++i) {
+        logger->SetLogSeverityLevel(i % 2 == 0
+                                        ? Log::LogSeverityLevel_TP::LOG_DEBUG
+                                        : Log::LogSeverityLevel_TP::LOG_INFO);
+    }
+    // Without readers every replaced snapshot is freed on the next update
+    // at the latest
+    logger->SetLogSeverityLevel(previous);
+    EXPECT_LE(logger->GetRetiredConfigCount(), 1u);
+}
+
+}  // namespace Log_Test
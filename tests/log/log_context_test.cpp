@@ -0,0 +1,121 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_context.h"
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+/** Routes INFO to a string stream with the given format */
+class ContextLogger_Test : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        Log::Logger_C* logger = Log::Logger_C::GetInstance();
+        m_log_type = logger->GetConfig().m_log_type;
+        m_format = logger->GetFormat();
+        logger->SetStream(Log::LogSeverityLevel_TP::LOG_INFO, m_stream);
+        logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    }
+
+    void TearDown() override {
+        Log::Logger_C* logger = Log::Logger_C::GetInstance();
+        logger->SetStream(Log::LogSeverityLevel_TP::LOG_INFO, std::cout);
+        logger->SetFormat(m_format);
+        logger->SetLogType(m_log_type);
+    }
+
+    std::ostringstream m_stream;
+    Log::LogType_TP m_log_type;
+    std::string m_format;
+};
+
+}  // namespace
+
+TEST(LogContext_Test, PushesAndPopsAttributes) {
+    EXPECT_EQ("", Log::LogContext_C::GetContext());
+    {
+        SN_LOG_SCOPE_CONTEXT("robot", "r7");
+        SN_LOG_SCOPE_CONTEXT("episode", 42);
+        EXPECT_EQ("robot=r7 episode=42", Log::LogContext_C::GetContext());
+    }
+    EXPECT_EQ("", Log::LogContext_C::GetContext());
+}
+
+TEST(LogContext_Test, ThreadNameKeepsAttributes) {
+    std::thread worker([] {
+        SN_LOG_SCOPE_CONTEXT("task", std::string("pick"));
+        Log::LogContext_C::SetThreadName("context_worker");
+        EXPECT_EQ("context_worker", Log::LogContext_C::GetThreadName());
+        {
+            SN_LOG_SCOPE_CONTEXT("step", 3);
+            EXPECT_EQ("task=pick step=3", Log::LogContext_C::GetContext());
+        }
+        EXPECT_EQ("task=pick", Log::LogContext_C::GetContext());
+        EXPECT_FALSE(Log::LogContext_C::GetThreadId().empty());
+    });
+    worker.join();
+}
+
+TEST_F(ContextLogger_Test, RendersContextTokens) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    logger->SetFormat("%N [%X] %S");
+    std::thread worker([] {
+        Log::LogContext_C::SetThreadName("sim");
+        SN_LOG_SCOPE_CONTEXT("episode", 5);
+        SN_LOG_INFO << "step";
+    });
+    worker.join();
+    EXPECT_EQ("sim [episode=5] step\n", m_stream.str());
+}
+
+TEST_F(ContextLogger_Test, AsyncRecordsOutliveTheirThread) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    logger->SetFormat("%I|%X|%S");
+    std::string thread_id;
+    logger->EnableAsyncLogging(16);
+    std::thread worker([&thread_id] {
+        thread_id = std::string(Log::LogContext_C::GetThreadId());
+        SN_LOG_SCOPE_CONTEXT("robot", "r1");
+        SN_LOG_INFO << "streamed";
+        Log::Logger_C::GetInstance()->LogWrite(
+            Log::LogSeverityLevel_TP::LOG_INFO, __FILE__, __func__, __LINE__,
+            "written");
+    });
+    worker.join();
+    logger->FlushOut();
+    logger->DisableAsyncLogging();
+    EXPECT_EQ(thread_id + "|robot=r1|streamed\n" + thread_id +
+                  "|robot=r1|written\n",
+              m_stream.str());
+}
+
+}  // namespace Log_Test
@@ -0,0 +1,166 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_format_kernels.h"
+#include "log/log_stream.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+std::string Unsigned(uint64_t value) {
+    char buffer[Log::Kernels::kMaxIntegerChars];
+    return std::string(buffer, Log::Kernels::FormatUnsigned(value, buffer));
+}
+
+std::string Signed(int64_t value) {
+    char buffer[Log::Kernels::kMaxIntegerChars];
+    return std::string(buffer, Log::Kernels::FormatSigned(value, buffer));
+}
+
+std::string Double(double value) {
+    char buffer[Log::Kernels::kMaxDoubleChars];
+    return std::string(buffer, Log::Kernels::FormatDouble(value, buffer));
+}
+
+std::string ReferenceHex(const std::vector<uint8_t>& bytes) {
+    std::string hex;
+    char digits[3];
+    for (uint8_t byte : bytes) {
+        std::snprintf(digits, sizeof(digits), "%02x", byte);
+        hex += digits;
+    }
+    return hex;
+}
+
+}  // namespace
+
+TEST(LogFormatKernels_Test, FormatsIntegers) {
+    uint64_t power = 1;
+    for (int digits = 1; digits < 20; ++digits, power *= 10) {
+        EXPECT_EQ(std::to_string(power), Unsigned(power));
+        EXPECT_EQ(std::to_string(power - 1), Unsigned(power - 1));
+    }
+    EXPECT_EQ("18446744073709551615",
+              Unsigned(std::numeric_limits<uint64_t>::max()));
+    EXPECT_EQ("-9223372036854775808",
+              Signed(std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ("-42", Signed(-42));
+}
+
+TEST(LogFormatKernels_Test, FormatsDoublesAndHex) {
+    EXPECT_EQ("0.1", Double(0.1));
+    EXPECT_EQ("0.30000000000000004", Double(0.1 + 0.2));
+    EXPECT_EQ("-2.5", Double(-2.5));
+
+    char buffer[Log::Kernels::kMaxFixedChars];
+    EXPECT_EQ("3.142", std::string(buffer, Log::Kernels::FormatFixed(
+                                               3.14159, 3, buffer)));
+    EXPECT_EQ("1e+300", std::string(buffer, Log::Kernels::FormatFixed(
+                                                1e300, 0, buffer)));
+    EXPECT_EQ("deadbeef", std::string(buffer, Log::Kernels::FormatHex(
+                                                  0xdeadbeef, buffer)));
+    EXPECT_EQ("0x0", std::string(buffer, Log::Kernels::FormatPointer(
+                                             nullptr, buffer)));
+}
+
+TEST(LogFormatKernels_Test, StreamFallsBackForFormatFlags) {
+    Log::LogBuffer_C buffer;
+    Log::LogStream_C stream(buffer);
+    stream << "n=" << 42 << ' ' << -7L << ' ' << 2.5 << ' '
+           << Log::Hex(255) << ' ' << Log::Fixed(1.0, 2) << ' '
+           << std::string("s") << ' ' << std::hex << 255 << std::dec << ' '
+           << std::setw(4) << 7 << ' ' << std::fixed << 1.5 << ' ' << true;
+    EXPECT_EQ("n=42 -7 2.5 0xff 1.00 s ff    7 1.500000 1",
+              std::string(buffer.View()));
+}
+
+TEST(LogFormatKernels_Test, EncodesBytes) {
+    // Cover the vector loop, its tail and every byte value
+    std::vector<uint8_t> bytes;
+    for (size_t size = 0; size <= 300; ++size) {
+        std::string hex(Log::Kernels::HexSize(size), '?');
+        ASSERT_EQ(hex.size(),
+                  Log::Kernels::EncodeHex(bytes.data(), size, &hex[0]));
+        ASSERT_EQ(ReferenceHex(bytes), hex) << "size " << size;
+        bytes.push_back(static_cast<uint8_t>(size * 37 + 11));
+    }
+
+    const uint8_t text[] = {'f', 'o', 'o', 'b', 'a', 'r'};
+    const char* expected[] = {"",     "Zg==",     "Zm8=",    "Zm9v",
+                              "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"};
+    char buffer[Log::Kernels::Base64Size(sizeof(text))];
+    for (size_t size = 0; size <= sizeof(text); ++size) {
+        EXPECT_EQ(expected[size],
+                  std::string(buffer, Log::Kernels::EncodeBase64(text, size,
+                                                                 buffer)));
+    }
+}
+
+TEST(LogFormatKernels_Test, FindsBytesAndText) {
+    // Cover the vector loop and its tail at every position
+    for (size_t size = 0; size <= 70; ++size) {
+        std::string text(size, 'a');
+        const char* end = text.data() + size;
+        ASSERT_EQ(end, Log::Kernels::FindByte(text.data(), end, '\n'));
+        for (size_t i = 0; i < size; ++i) {
+            text[i] = '\n';
+            ASSERT_EQ(text.data() + i,
+                      Log::Kernels::FindByte(text.data(), end, '\n'))
+                << "size " << size << " at " << i;
+            text[i] = 'a';
+        }
+    }
+
+    std::string line = "[1] [a.cpp:1 f] [INFO] :: ] [ x] [y";
+    const char* end = line.data() + line.size();
+    EXPECT_EQ(line.data() + 2,
+              Log::Kernels::FindText(line.data(), end, "] [", 3));
+    EXPECT_EQ(line.data() + 22,
+              Log::Kernels::FindText(line.data(), end, " :: ", 4));
+    EXPECT_EQ(end, Log::Kernels::FindText(line.data(), end, "[z", 2));
+    EXPECT_EQ(line.data() + line.size() - 2,
+              Log::Kernels::FindText(line.data(), end, "[y", 2));
+}
+
+TEST(LogFormatKernels_Test, StreamTruncatesBytes) {
+    const uint8_t frame[] = {0x12, 0x34, 0xab, 0xcd, 0xef};
+    Log::LogBuffer_C buffer;
+    Log::LogStream_C stream(buffer);
+    stream << Log::HexBytes(frame, sizeof(frame)) << ' '
+           << Log::HexBytes(frame, sizeof(frame), 2) << ' '
+           << Log::Base64Bytes(frame, 3);
+    EXPECT_EQ("1234abcdef 1234...(+3 bytes) EjSr", std::string(buffer.View()));
+}
+
+}  // namespace Log_Test
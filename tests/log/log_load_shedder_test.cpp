@@ -0,0 +1,195 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   MAY-2021
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_load_shedder.h"
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+using Level = Log::LogSeverityLevel_TP;
+using ms = std::chrono::milliseconds;
+using us = std::chrono::microseconds;
+
+Log::LoadSheddingSettings_TP Settings() {
+    Log::LoadSheddingSettings_TP settings;
+    settings.m_enabled = true;
+    settings.m_step = ms(10);
+    settings.m_hold = ms(100);
+    settings.m_max_level = Level::LOG_WARN;
+    return settings;
+}
+
+}  // namespace
+
+TEST(LogLoadShedder_Test, RaisesStepwiseAndRestoresWithHysteresis) {
+    Log::LogLoadShedder_C shedder;
+    Log::LoadSheddingSettings_TP settings = Settings();
+    auto now = Log::LogLoadShedder_C::Clock_TP::now();
+    us fast(1);
+
+    EXPECT_FALSE(shedder.Observe(settings, Level::LOG_DEBUG, 0.5, fast, now));
+    EXPECT_FALSE(shedder.IsShedding());
+
+    // Full queue, one step at a time
+    EXPECT_TRUE(shedder.Observe(settings, Level::LOG_DEBUG, 0.9, fast, now));
+    EXPECT_EQ(Level::LOG_INFO, shedder.GetLevel());
+    EXPECT_FALSE(
+        shedder.Observe(settings, Level::LOG_DEBUG, 0.9, fast, now + ms(5)));
+    // A slow output counts as pressure as well
+    EXPECT_TRUE(shedder.Observe(settings, Level::LOG_DEBUG, 0.1, ms(1),
+                                now + ms(10)));
+    EXPECT_EQ(Level::LOG_WARN, shedder.GetLevel());
+    EXPECT_FALSE(
+        shedder.Observe(settings, Level::LOG_DEBUG, 0.9, fast, now + ms(50)));
+    EXPECT_EQ(Level::LOG_WARN, shedder.GetLevel());
+
+    shedder.CountShed(Level::LOG_DEBUG);
+    shedder.CountShed(Level::LOG_INFO);
+    shedder.CountShed(Level::LOG_INFO);
+
+    // Low pressure has to last for the hold time, in between resets it
+    now += ms(100);
+    EXPECT_FALSE(shedder.Observe(settings, Level::LOG_DEBUG, 0.0, fast, now));
+    EXPECT_FALSE(
+        shedder.Observe(settings, Level::LOG_DEBUG, 0.5, fast, now + ms(60)));
+    EXPECT_FALSE(shedder.Observe(settings, Level::LOG_DEBUG, 0.0, fast,
+                                 now + ms(120)));
+    EXPECT_FALSE(shedder.Observe(settings, Level::LOG_DEBUG, 0.0, fast,
+                                 now + ms(200)));
+    EXPECT_TRUE(shedder.Observe(settings, Level::LOG_DEBUG, 0.0, fast,
+                                now + ms(220)));
+    EXPECT_EQ(Level::LOG_INFO, shedder.GetLevel());
+    EXPECT_TRUE(shedder.Observe(settings, Level::LOG_DEBUG, 0.0, fast,
+                                now + ms(320)));
+    EXPECT_FALSE(shedder.IsShedding());
+
+    Log::LogRecord_TP summary;
+    ASSERT_TRUE(shedder.TakeSummary(summary));
+    EXPECT_EQ(Level::LOG_WARN, summary.m_level);
+    EXPECT_EQ(
+        "Load shedding raised the level up to WARN for 420 ms and shed 3 log "
+        "records (DEBUG: 1, INFO: 2)",
+        summary.m_message);
+    EXPECT_FALSE(shedder.TakeSummary(summary));
+}
+
+TEST(LogLoadShedder_Test, NeverRaisesAboveTheMaximumLevel) {
+    Log::LogLoadShedder_C shedder;
+    Log::LoadSheddingSettings_TP settings = Settings();
+    auto now = Log::LogLoadShedder_C::Clock_TP::now();
+    // ERROR and FATAL always get through
+    EXPECT_FALSE(shedder.Observe(settings, Level::LOG_WARN, 1.0, us(1), now));
+    EXPECT_FALSE(shedder.IsShedding());
+
+    EXPECT_TRUE(shedder.Observe(settings, Level::LOG_INFO, 1.0, us(1), now));
+    settings.m_enabled = false;
+    EXPECT_TRUE(shedder.Observe(settings, Level::LOG_INFO, 1.0, us(1), now));
+    EXPECT_FALSE(shedder.IsShedding());
+}
+
+namespace {
+
+/** Writes slowly and keeps the messages */
+class SlowSink_C : public Log::LogSink_C {
+   public:
+    void Write(const Log::LogRecord_TP& record, const char*,
+               size_t) override {
+        std::this_thread::sleep_for(us(50));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_messages.append(record.m_message).append("\n");
+    }
+
+    std::string GetMessages() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_messages;
+    }
+
+   private:
+    std::mutex m_mutex;
+    std::string m_messages;
+};
+
+}  // namespace
+
+TEST(LogLoadShedder_Test, LoggerShedsFloodAndReportsIt) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    logger->SetLogSeverityLevel(Level::LOG_INFO);
+    logger->SetOverflowPolicy(Log::OverflowPolicy_TP::DROP_NEWEST);
+    Log::LoadSheddingSettings_TP settings = Settings();
+    settings.m_hold = ms(40);
+    logger->SetLoadShedding(settings);
+    auto sink = std::make_shared<SlowSink_C>();
+    logger->AddSink(sink);
+    std::ostringstream stream;
+    logger->SetStream(Level::LOG_INFO, stream);
+    logger->SetStream(Level::LOG_WARN, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->EnableAsyncLogging(64);
+
+    const Log::LogLoadShedder_C& shedder = logger->GetLoadShedder();
+    uint64_t shed_before = shedder.GetShedCount(Level::LOG_INFO);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!shedder.IsShedding() &&
+           std::chrono::steady_clock::now() < deadline) {
+        SN_LOG_INFO << "flood";
+    }
+    EXPECT_EQ(Level::LOG_WARN, shedder.GetLevel());
+    for (int i = 0; i < 100; ++i) {
+        SN_LOG_INFO << "shed";
+    }
+    SN_LOG_WARN << "still logged";
+    while (shedder.IsShedding() &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(ms(5));
+    }
+    EXPECT_FALSE(shedder.IsShedding());
+    SN_LOG_INFO << "restored";
+    logger->DisableAsyncLogging();
+
+    logger->RemoveSink(sink);
+    logger->SetStream(Level::LOG_INFO, std::cout);
+    logger->SetStream(Level::LOG_WARN, std::cerr);
+    logger->SetConfig(saved);
+    EXPECT_GE(shedder.GetShedCount(Level::LOG_INFO) - shed_before, 100u);
+    std::string messages = sink->GetMessages();
+    EXPECT_EQ(std::string::npos, messages.find("shed\n"));
+    EXPECT_NE(std::string::npos, messages.find("still logged\n"));
+    EXPECT_NE(std::string::npos,
+              messages.find("Load shedding raised the level up to WARN"));
+    EXPECT_NE(std::string::npos, messages.find("restored\n"));
+}
+
+}  // namespace Log_Test
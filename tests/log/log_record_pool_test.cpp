@@ -0,0 +1,76 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+using namespace SN;
+
+namespace Log_Test {
+TEST(LogRecordPool_Test, RecyclesThreadSlabs) {
+    Log::LogRecordPool_C* pool = Log::LogRecordPool_C::GetInstance();
+    Log::LogSlab_TP* first = pool->Acquire(100);
+    pool->Release(first);
+    int64_t allocated = pool->GetStats().m_allocated;
+    for (int i = 0; i < 1000; ++i) {
+        pool->Release(pool->Acquire(Log::LogRecordPool_C::kSlabSize));
+    }
+    EXPECT_EQ(allocated, pool->GetStats().m_allocated);
+}
+
+TEST(LogRecordPool_Test, ReturnsSlabsReleasedByOtherThreads) {
+    Log::LogRecordPool_C* pool = Log::LogRecordPool_C::GetInstance();
+    Log::LogSlab_TP* slab = pool->Acquire(10);
+    int64_t in_use = pool->GetStats().m_in_use;
+    std::thread([pool, slab]() { pool->Release(slab); }).join();
+    EXPECT_EQ(in_use - 1, pool->GetStats().m_in_use);
+}
+
+TEST(LogRecordPool_Test, CountsFallbacks) {
+    Log::LogRecordPool_C* pool = Log::LogRecordPool_C::GetInstance();
+    Log::LogPoolStats_TP before = pool->GetStats();
+    pool->Release(pool->Acquire(2000));
+    pool->Release(pool->Acquire(20000));
+    pool->Release(pool->Acquire(200000));
+    Log::LogPoolStats_TP after = pool->GetStats();
+    EXPECT_EQ(before.m_fallback[0] + 1, after.m_fallback[0]);
+    EXPECT_EQ(before.m_fallback[1] + 1, after.m_fallback[1]);
+    EXPECT_EQ(before.m_oversize + 1, after.m_oversize);
+    EXPECT_GE(after.m_high_water_mark, after.m_in_use);
+}
+
+TEST(LogRecordPool_Test, BufferGrowsAcrossSizeClasses) {
+    Log::LogBuffer_C buffer;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        buffer.Append("0123456789", 10);
+        expected += "0123456789";
+    }
+    EXPECT_EQ(expected, std::string(buffer.View()));
+}
+
+}  // namespace Log_Test
@@ -0,0 +1,88 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+using namespace SN;
+
+namespace Log_Test {
+TEST(LogSampling_Test, EveryNLetsOneOutOfNThrough) {
+    std::atomic<uint64_t> counter{0};
+    uint32_t emitted = 0;
+    for (int i = 0; i < 100; ++i) {
+        uint32_t rate = Log::Sampling::EveryN(counter, 10);
+        if (rate != 0) {
+            EXPECT_EQ(10u, rate);
+            ++emitted;
+        }
+    }
+    EXPECT_EQ(10u, emitted);
+}
+
+TEST(LogSampling_Test, FirstNStopsAfterN) {
+    std::atomic<uint64_t> counter{0};
+    uint32_t emitted = 0;
+    for (int i = 0; i < 100; ++i) {
+        emitted += Log::Sampling::FirstN(counter, 3);
+    }
+    EXPECT_EQ(3u, emitted);
+}
+
+TEST(LogSampling_Test, EveryTCarriesSkippedHits) {
+    Log::EveryTSamplerState_TP state;
+    EXPECT_EQ(1u, Log::Sampling::EveryT(state, 60000));
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(0u, Log::Sampling::EveryT(state, 60000));
+    }
+    // Open the next period and check the record stands for all hits since
+    state.m_next_ns.store(0);
+    EXPECT_EQ(6u, Log::Sampling::EveryT(state, 60000));
+}
+
+TEST(LogSampling_Test, FractionBounds) {
+    EXPECT_EQ(1u, Log::Sampling::Fraction(1.0));
+    EXPECT_EQ(0u, Log::Sampling::Fraction(0.0));
+    uint32_t emitted = 0;
+    for (int i = 0; i < 10000; ++i) {
+        if (Log::Sampling::Fraction(0.25) != 0) {
+            ++emitted;
+        }
+    }
+    EXPECT_NEAR(2500, emitted, 300);
+}
+
+TEST(LogSampling_Test, MacrosSkipDisabledLevels) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    logger->SetLogType(Log::LogType_TP::NO_LOG);
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+    int evaluated = 0;
+    for (int i = 0; i < 10; ++i) {
+        SN_LOG_EVERY_N(Log::LogSeverityLevel_TP::LOG_DEBUG, 2) << ++evaluated;
+        SN_LOG_FIRST_N(Log::LogSeverityLevel_TP::LOG_INFO, 3) << ++evaluated;
+    }
+    EXPECT_EQ(3, evaluated);
+}
+
+}  // namespace Log_Test
@@ -0,0 +1,163 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_shm_ring.h"
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+const Log::LogSeverityLevel_TP kInfo = Log::LogSeverityLevel_TP::LOG_INFO;
+
+/** Unique ring per test, removed again at the end */
+class ShmLogRing_Test : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        const ::testing::TestInfo* test =
+            ::testing::UnitTest::GetInstance()->current_test_info();
+        m_name = "/sn_log_test_" + std::to_string(getpid()) + "_" +
+                 test->name();
+    }
+    void TearDown() override { Log::ShmLogRing_C::Unlink(m_name); }
+
+    std::unique_ptr<Log::ShmLogRing_C> Open(size_t capacity) {
+        std::string error;
+        std::unique_ptr<Log::ShmLogRing_C> ring =
+            Log::ShmLogRing_C::Open(m_name, capacity, 256, error);
+        EXPECT_TRUE(ring) << error;
+        return ring;
+    }
+
+    std::string m_name;
+};
+
+}  // namespace
+
+TEST_F(ShmLogRing_Test, CollectsEntriesOfSeveralProcesses) {
+    std::unique_ptr<Log::ShmLogRing_C> collector = Open(1024);
+    ASSERT_TRUE(collector && collector->AttachConsumer());
+    const int kProcesses = 3;
+    const int kEntries = 200;
+    for (int process = 0; process < kProcesses; ++process) {
+        pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            std::string error;
+            std::unique_ptr<Log::ShmLogRing_C> ring =
+                Log::ShmLogRing_C::Open(m_name, 0, 0, error);
+            for (int i = 0; ring && i < kEntries; ++i) {
+                std::string entry = std::to_string(i) + "\n";
+                ring->TryPush(kInfo, entry.data(), entry.size());
+            }
+            _exit(ring ? 0 : 1);
+        }
+    }
+    for (int process = 0; process < kProcesses; ++process) {
+        int status = 0;
+        wait(&status);
+        EXPECT_EQ(0, status);
+    }
+
+    // Every process' entries arrive complete and in order
+    std::map<uint32_t, int> next;
+    Log::ShmLogEntry_TP entry;
+    int count = 0;
+    while (collector->TryPop(entry)) {
+        EXPECT_EQ(std::to_string(next[entry.m_pid]++) + "\n", entry.m_text);
+        ++count;
+    }
+    EXPECT_EQ(kProcesses * kEntries, count);
+    EXPECT_EQ(0u, collector->GetDroppedCount());
+}
+
+TEST_F(ShmLogRing_Test, DropsWhenFullAndSurvivesCollectorRestart) {
+    std::unique_ptr<Log::ShmLogRing_C> producer = Open(4);
+    ASSERT_TRUE(producer);
+    for (int i = 0; i < 6; ++i) {
+        producer->TryPush(kInfo, "entry\n", 6);
+    }
+    EXPECT_EQ(2u, producer->GetDroppedCount());
+
+    Log::ShmLogEntry_TP entry;
+    {
+        std::unique_ptr<Log::ShmLogRing_C> collector = Open(4);
+        ASSERT_TRUE(collector->AttachConsumer());
+        // Only one collector at a time
+        EXPECT_FALSE(Open(4)->AttachConsumer());
+        EXPECT_TRUE(collector->TryPop(entry));
+    }
+    std::unique_ptr<Log::ShmLogRing_C> restarted = Open(4);
+    ASSERT_TRUE(restarted->AttachConsumer());
+    int count = 0;
+    while (restarted->TryPop(entry)) {
+        ++count;
+    }
+    EXPECT_EQ(3, count);
+}
+
+TEST_F(ShmLogRing_Test, OnlyOwnerMayAccessRing) {
+    std::unique_ptr<Log::ShmLogRing_C> ring = Open(4);
+    ASSERT_TRUE(ring);
+    struct stat status;
+    // Linux keeps the shared memory objects in /dev/shm
+    if (stat(("/dev/shm" + m_name).c_str(), &status) != 0) {
+        GTEST_SKIP() << "shared memory objects are not visible";
+    }
+    EXPECT_EQ(0600u, status.st_mode & 0777u);
+}
+
+TEST_F(ShmLogRing_Test, LoggerWritesThroughSink) {
+    std::unique_ptr<Log::ShmLogRing_C> collector = Open(64);
+    ASSERT_TRUE(collector->AttachConsumer());
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogType_TP log_type = logger->GetConfig().m_log_type;
+    std::string format = logger->GetFormat();
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->SetFormat("%L %S");
+    auto sink = std::make_shared<Log::ShmLogSink_C>(Open(64));
+    logger->AddSink(sink);
+    SN_LOG_ERROR << "to the collector";
+    logger->RemoveSink(sink);
+    logger->SetFormat(format);
+    logger->SetLogType(log_type);
+
+    Log::ShmLogEntry_TP entry;
+    ASSERT_TRUE(collector->TryPop(entry));
+    EXPECT_EQ("ERROR to the collector\n", entry.m_text);
+    EXPECT_EQ(Log::LogSeverityLevel_TP::LOG_ERROR, entry.m_level);
+    EXPECT_EQ(static_cast<uint32_t>(getpid()), entry.m_pid);
+}
+
+}  // namespace Log_Test
@@ -0,0 +1,154 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_site_profiler.h"
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+constexpr char kFileName[] = "log_site_profiler_test.txt";
+
+/** Finds the counters of a site of this file */
+const Log::LogSiteStats_TP* FindSite(
+    const std::vector<Log::LogSiteStats_TP>& sites, uint32_t line) {
+    for (const Log::LogSiteStats_TP& site : sites) {
+        if (site.m_line == line && std::strcmp(site.m_file, __FILE__) == 0) {
+            return &site;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST(LogSiteProfiler_Test, CountsHitsBytesAndFilteredMessages) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+    logger->ClearSiteRules();
+    logger->Init(kFileName);
+
+    Log::LogSiteProfiler_C* profiler = Log::LogSiteProfiler_C::GetInstance();
+    profiler->Reset();
+    profiler->Enable();
+    uint32_t noisy_line = 0;
+    uint32_t quiet_line = 0;
+    uint32_t filtered_line = 0;
+    for (int i = 0; i < 100; ++i) {
+        noisy_line = __LINE__ + 1;
+        SN_LOG_INFO << "noisy site " << std::string(40, 'x') << ' ' << i;
+        if (i % 10 == 0) {
+            quiet_line = __LINE__ + 1;
+            SN_LOG_INFO << "quiet site";
+        }
+        filtered_line = __LINE__ + 1;
+        SN_LOG_DEBUG << "filtered site";
+    }
+    profiler->Disable();
+    // Not counted once disabled
+    uint32_t unprofiled_line = __LINE__ + 1;
+    SN_LOG_INFO << "unprofiled site";
+
+    std::vector<Log::LogSiteStats_TP> by_bytes =
+        profiler->GetTopSites(Log::LogSiteSortKey_TP::BYTES, 1000);
+    const Log::LogSiteStats_TP* noisy = FindSite(by_bytes, noisy_line);
+    const Log::LogSiteStats_TP* quiet = FindSite(by_bytes, quiet_line);
+    const Log::LogSiteStats_TP* filtered = FindSite(by_bytes, filtered_line);
+    ASSERT_NE(nullptr, noisy);
+    ASSERT_NE(nullptr, quiet);
+    ASSERT_NE(nullptr, filtered);
+    EXPECT_EQ(nullptr, FindSite(by_bytes, unprofiled_line));
+
+    EXPECT_EQ(100u, noisy->m_hits);
+    EXPECT_EQ(0u, noisy->m_filtered);
+    EXPECT_GE(noisy->m_bytes, 100u * 52);
+    EXPECT_EQ(10u, quiet->m_hits);
+    EXPECT_EQ(10u * std::strlen("quiet site"), quiet->m_bytes);
+    EXPECT_EQ(100u, filtered->m_hits);
+    EXPECT_EQ(100u, filtered->m_filtered);
+    EXPECT_EQ(0u, filtered->m_bytes);
+    EXPECT_EQ(0u, filtered->m_format_ns);
+    EXPECT_STREQ("TestBody", noisy->m_function);
+    EXPECT_LT(noisy - by_bytes.data(), quiet - by_bytes.data());
+
+    std::ostringstream report;
+    profiler->WriteReport(report, 3);
+    EXPECT_NE(std::string::npos, report.str().find("Top 3 log sites by bytes"));
+    EXPECT_NE(std::string::npos,
+              report.str().find(std::to_string(noisy_line) + " TestBody"));
+
+    profiler->Reset();
+    EXPECT_EQ(0u, FindSite(profiler->GetTopSites(
+                               Log::LogSiteSortKey_TP::HITS, 1000),
+                           noisy_line)
+                      ->m_hits);
+
+    logger->SetConfig(saved);
+    std::remove(kFileName);
+}
+
+TEST(LogSiteProfiler_Test, SampledOutHitsCountAsFiltered) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+    logger->ClearSiteRules();
+    logger->Init(kFileName);
+
+    Log::LogSiteProfiler_C* profiler = Log::LogSiteProfiler_C::GetInstance();
+    profiler->Reset();
+    profiler->Enable();
+    uint32_t sampled_line = 0;
+    for (int i = 0; i < 100; ++i) {
+        sampled_line = __LINE__ + 1;
+        SN_LOG_EVERY_N(Log::LogSeverityLevel_TP::LOG_INFO, 10) << "sampled";
+    }
+    profiler->Disable();
+    // The last hit was sampled out, it must not leave the site current
+    EXPECT_EQ(nullptr, Log::LogSiteProfiler_C::TakeCurrentSite());
+
+    const Log::LogSiteStats_TP* sampled = FindSite(
+        profiler->GetTopSites(Log::LogSiteSortKey_TP::HITS, 1000),
+        sampled_line);
+    ASSERT_NE(nullptr, sampled);
+    EXPECT_EQ(100u, sampled->m_hits);
+    EXPECT_EQ(90u, sampled->m_filtered);
+    EXPECT_EQ(10u * std::strlen("sampled"), sampled->m_bytes);
+
+    logger->SetConfig(saved);
+    std::remove(kFileName);
+}
+
+}  // namespace Log_Test
@@ -0,0 +1,231 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_socket_sink.h"
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+/** Listening Unix domain stream socket, removed again at the end */
+class UnixListener_C {
+   public:
+    explicit UnixListener_C(const std::string& path) : m_path(path) {
+        unlink(m_path.c_str());
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(),
+                     sizeof(address.sun_path) - 1);
+        m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        EXPECT_EQ(0, bind(m_socket, reinterpret_cast<sockaddr*>(&address),
+                          sizeof(address)));
+        EXPECT_EQ(0, listen(m_socket, 4));
+    }
+
+    ~UnixListener_C() {
+        if (m_client >= 0) {
+            close(m_client);
+        }
+        close(m_socket);
+        unlink(m_path.c_str());
+    }
+
+    /** Reads until size bytes arrived or the timeout passed */
+    std::string Read(size_t size, int timeout_ms = 2000) {
+        std::string data;
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeout_ms);
+        while (data.size() < size &&
+               std::chrono::steady_clock::now() < deadline) {
+            pollfd poll_fd{m_client >= 0 ? m_client : m_socket, POLLIN, 0};
+            if (poll(&poll_fd, 1, 10) != 1) {
+                continue;
+            }
+            if (m_client < 0) {
+                m_client = accept(m_socket, nullptr, nullptr);
+                continue;
+            }
+            char buffer[4096];
+            ssize_t received = read(m_client, buffer, sizeof(buffer));
+            if (received <= 0) {
+                break;
+            }
+            data.append(buffer, static_cast<size_t>(received));
+        }
+        return data;
+    }
+
+   private:
+    std::string m_path;
+    int m_socket = -1;
+    int m_client = -1;
+};
+
+std::string SocketPath(const std::string& name) {
+    return "/tmp/sn_log_test_" + std::to_string(getpid()) + "_" + name +
+           ".sock";
+}
+
+void Write(Log::SocketSink_C& sink, const std::string& entry,
+           uint32_t line = 0) {
+    Log::LogRecord_TP record;
+    record.m_level = Log::LogSeverityLevel_TP::LOG_WARN;
+    record.m_line = line;
+    record.m_time = Log::LogClock_C::GetInstance()->Now();
+    sink.Write(record, entry.data(), entry.size());
+}
+
+}  // namespace
+
+TEST(SocketSink_Test, UnixSocketReceivesBatchedEntries) {
+    std::string path = SocketPath("batched");
+    UnixListener_C listener(path);
+    Log::SocketSinkOptions_TP options;
+    options.m_batch_delay = std::chrono::milliseconds(1000);
+    Log::SocketSink_C sink("unix:" + path, options);
+    ASSERT_TRUE(sink.IsValid());
+    Write(sink, "first\n");
+    Write(sink, "second\n");
+    // Held back until the batch is due or flushed
+    EXPECT_EQ("", listener.Read(1, 100));
+    sink.Flush();
+    EXPECT_EQ("first\nsecond\n", listener.Read(13));
+    // The data can arrive before the sender has counted it
+    for (int i = 0; i < 200 && sink.GetSentCount() != 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(2u, sink.GetSentCount());
+}
+
+TEST(SocketSink_Test, SendsDueBatchWithoutFlush) {
+    std::string path = SocketPath("due");
+    UnixListener_C listener(path);
+    Log::SocketSinkOptions_TP options;
+    options.m_batch_delay = std::chrono::milliseconds(50);
+    Log::SocketSink_C sink("unix:" + path, options);
+    ASSERT_TRUE(sink.IsValid());
+    auto start = std::chrono::steady_clock::now();
+    Write(sink, "alone\n");
+    EXPECT_EQ("alone\n", listener.Read(6, 1000));
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(500));
+}
+
+TEST(SocketSink_Test, UdpDatagramHoldsWholeFrames) {
+    int receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(0, bind(receiver, reinterpret_cast<sockaddr*>(&address),
+                      sizeof(address)));
+    socklen_t length = sizeof(address);
+    getsockname(receiver, reinterpret_cast<sockaddr*>(&address), &length);
+
+    Log::SocketSinkOptions_TP options;
+    options.m_framing = Log::SocketFraming_TP::BINARY;
+    Log::SocketSink_C sink(
+        "udp:127.0.0.1:" + std::to_string(ntohs(address.sin_port)), options);
+    Write(sink, "one", 7);
+    Write(sink, "three", 42);
+    sink.Flush();
+
+    pollfd poll_fd{receiver, POLLIN, 0};
+    ASSERT_EQ(1, poll(&poll_fd, 1, 2000));
+    char datagram[1024];
+    ssize_t received = recv(receiver, datagram, sizeof(datagram), 0);
+    close(receiver);
+    const size_t header_size = sizeof(Log::SocketFrameHeader_TP);
+    ASSERT_EQ(static_cast<ssize_t>(2 * header_size + 8), received);
+
+    Log::SocketFrameHeader_TP header;
+    std::memcpy(&header, datagram, header_size);
+    EXPECT_EQ(header_size - 4 + 3, ntohl(header.m_size));
+    EXPECT_EQ(Log::kSocketFrameVersion, header.m_version);
+    EXPECT_EQ(static_cast<uint8_t>(Log::LogSeverityLevel_TP::LOG_WARN),
+              header.m_level);
+    EXPECT_EQ(7u, ntohl(header.m_line));
+    EXPECT_EQ("one", std::string(datagram + header_size, 3));
+    std::memcpy(&header, datagram + header_size + 3, header_size);
+    EXPECT_EQ(42u, ntohl(header.m_line));
+    EXPECT_EQ("three", std::string(datagram + 2 * header_size + 3, 5));
+}
+
+TEST(SocketSink_Test, ReconnectsWithoutBlockingWriters) {
+    std::string path = SocketPath("reconnect");
+    unlink(path.c_str());
+    Log::SocketSinkOptions_TP options;
+    options.m_batch_delay = std::chrono::milliseconds(1);
+    Log::SocketSink_C sink("unix:" + path, options);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        Write(sink, std::to_string(i % 10));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(100));
+    // Let the first attempt fail
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(sink.IsConnected());
+
+    UnixListener_C listener(path);
+    std::string data = listener.Read(100);
+    EXPECT_EQ(100u, data.size());
+    EXPECT_EQ("0123456789", data.substr(0, 10));
+    EXPECT_TRUE(sink.IsConnected());
+    EXPECT_EQ(0u, sink.GetDroppedCount());
+}
+
+TEST(SocketSink_Test, DropsBeyondBufferLimit) {
+    Log::SocketSinkOptions_TP options;
+    options.m_max_buffered_bytes = 64;
+    Log::SocketSink_C sink("unix:" + SocketPath("unreachable"), options);
+    for (int i = 0; i < 10; ++i) {
+        Write(sink, "sixteen bytes..\n");
+    }
+    EXPECT_EQ(6u, sink.GetDroppedCount());
+}
+
+TEST(SocketSink_Test, RejectsInvalidEndpoint) {
+    EXPECT_FALSE(Log::SocketSink_C("tcp:localhost").IsValid());
+    EXPECT_FALSE(Log::SocketSink_C("http://localhost:80").IsValid());
+    EXPECT_TRUE(Log::SocketSink_C("tcp:[::1]:9000").IsValid());
+}
+
+}  // namespace Log_Test
@@ -0,0 +1,205 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_config.h"
+#include "log/log_stats.h"
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+constexpr char kStatsFile[] = "log_stats_test.log";
+
+const size_t kInfo = static_cast<size_t>(Log::LogSeverityLevel_TP::LOG_INFO);
+const size_t kWarn = static_cast<size_t>(Log::LogSeverityLevel_TP::LOG_WARN);
+const size_t kError =
+    static_cast<size_t>(Log::LogSeverityLevel_TP::LOG_ERROR);
+
+std::string DefaultFormat() {
+    return Log::LogConfig_TP().m_format.GetFormatString();
+}
+
+}  // namespace
+
+TEST(LogStats_Test, CountsLevelsSitesAndBuckets) {
+    Log::LogStatsParser_C parser(DefaultFormat(),
+                                 Log::TimeStampMode_TP::EPOCH_SECONDS, 60);
+    Log::LogStats_TP stats;
+    parser.ParseChunk("[120] [src/a.cpp:10 Run] [ERROR] :: failed\n"
+                      "[125] [src/a.cpp:10 Run] [ERROR] :: failed again\n"
+                      "  continuation of the message\n"
+                      "[185] [src/b.cpp:7 Init] [INFO] :: ok] [done\r\n"
+                      "[-1] [src/b.cpp:?? Init] [WARN] :: early",
+                      stats);
+    EXPECT_EQ(5u, stats.m_lines);
+    EXPECT_EQ(1u, stats.m_unparsed);
+    EXPECT_EQ(2u, stats.m_levels[kError]);
+    EXPECT_EQ(1u, stats.m_levels[kInfo]);
+    EXPECT_EQ(1u, stats.m_levels[kWarn]);
+
+    ASSERT_EQ(3u, stats.m_sites.size());
+    EXPECT_EQ(2u, stats.m_sites["src/a.cpp:10 Run"][kError]);
+    EXPECT_EQ(1u, stats.m_sites["src/b.cpp:7 Init"][kInfo]);
+    EXPECT_EQ(1u, stats.m_sites["src/b.cpp:?? Init"][kWarn]);
+
+    ASSERT_EQ(3u, stats.m_buckets.size());
+    EXPECT_EQ(1u, stats.m_buckets[-60][kWarn]);
+    EXPECT_EQ(2u, stats.m_buckets[120][kError]);
+    EXPECT_EQ(1u, stats.m_buckets[180][kInfo]);
+
+    std::ostringstream report;
+    Log::WriteLogStats(stats, report, Log::LogSeverityLevel_TP::LOG_ERROR,
+                       10);
+    EXPECT_NE(std::string::npos, report.str().find("  src/a.cpp:10 Run\n"));
+    // Sites without errors are not ranked
+    EXPECT_EQ(std::string::npos, report.str().find("Init"));
+    EXPECT_NE(std::string::npos, report.str().find("1970-01-01 00:02:00"));
+}
+
+TEST(LogStats_Test, ParsesDateTimeStamps) {
+    Log::LogStatsParser_C parser(DefaultFormat(),
+                                 Log::TimeStampMode_TP::DATE_TIME, 60);
+    Log::LogStats_TP stats;
+    parser.ParseChunk(
+        "[Sun Oct 18 12:34:56 2026] [a.cpp:1 f] [INFO] :: one\n"
+        "[Thu Oct  8 01:02:03 2026] [a.cpp:1 f] [INFO] :: two\n"
+        "[Thu Smarch  8 01:02:03 2026] [a.cpp:1 f] [INFO] :: three\n",
+        stats);
+    EXPECT_EQ(3u, stats.m_levels[kInfo]);
+    ASSERT_EQ(2u, stats.m_buckets.size());
+    EXPECT_EQ(1u, stats.m_buckets[1792326840][kInfo]);
+    EXPECT_EQ(1u, stats.m_buckets[1791421320][kInfo]);
+}
+
+TEST(LogStats_Test, ParsesWhatTheLoggerWrites) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP config = logger->GetConfig();
+    std::ostringstream stream;
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->SetFormat(DefaultFormat());
+    logger->SetTimeStampMode(Log::TimeStampMode_TP::EPOCH_MILLI_SECONDS);
+    for (int i = 0; i < 3; ++i) {
+        SN_LOG_WARN << "warning " << i;
+    }
+    logger->FlushOut();
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, std::cerr);
+    logger->SetConfig(config);
+
+    Log::LogStatsParser_C parser(
+        DefaultFormat(), Log::TimeStampMode_TP::EPOCH_MILLI_SECONDS, 3600);
+    Log::LogStats_TP stats;
+    parser.ParseChunk(stream.str(), stats);
+    EXPECT_EQ(0u, stats.m_unparsed);
+    EXPECT_EQ(3u, stats.m_levels[kWarn]);
+    ASSERT_EQ(1u, stats.m_sites.size());
+    EXPECT_NE(std::string::npos,
+              stats.m_sites.begin()->first.find("log_stats_test.cpp:"));
+    uint64_t bucketed = 0;
+    for (const auto& bucket : stats.m_buckets) {
+        bucketed += bucket.second[kWarn];
+    }
+    EXPECT_EQ(3u, bucketed);
+}
+
+TEST(LogStats_Test, SplitsChunksAtLineBreaks) {
+    std::string data;
+    for (int i = 0; i < 1000; ++i) {
+        data += std::string(static_cast<size_t>(i % 37), 'x') + '\n';
+    }
+    data += "no line break";
+    for (size_t chunks : {1u, 3u, 16u, 5000u}) {
+        std::vector<std::string_view> parts =
+            Log::SplitLogChunks(data, chunks);
+        ASSERT_FALSE(parts.empty());
+        EXPECT_LE(parts.size(), chunks);
+        std::string joined;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (i + 1 < parts.size()) {
+                EXPECT_EQ('\n', parts[i].back());
+            }
+            joined.append(parts[i].data(), parts[i].size());
+        }
+        EXPECT_EQ(data, joined);
+    }
+    EXPECT_TRUE(Log::SplitLogChunks(std::string_view(), 4).empty());
+}
+
+TEST(LogStats_Test, CollectsFilesInParallel) {
+    // Large enough to be split into several chunks
+    std::string data;
+    const char* levels[] = {"INFO", "WARN", "ERROR"};
+    for (int i = 0; i < 80000; ++i) {
+        data += "[" + std::to_string(1000 + i / 10) + "] [src/file" +
+                std::to_string(i % 7) + ".cpp:" + std::to_string(i % 13) +
+                " Function] [" + levels[i % 3] + "] :: message " +
+                std::to_string(i) + "\n";
+    }
+    {
+        std::ofstream file(kStatsFile, std::ios::binary);
+        file << data;
+    }
+    Log::LogStatsParser_C parser(DefaultFormat(),
+                                 Log::TimeStampMode_TP::EPOCH_SECONDS, 60);
+    Log::LogStats_TP serial;
+    parser.ParseChunk(data, serial);
+
+    Log::LogStats_TP parallel;
+    std::string error;
+    EXPECT_TRUE(Log::CollectLogStats({kStatsFile, kStatsFile}, parser, 4,
+                                     parallel, error));
+    EXPECT_TRUE(error.empty()) << error;
+    std::remove(kStatsFile);
+
+    EXPECT_EQ(2 * serial.m_lines, parallel.m_lines);
+    EXPECT_EQ(0u, parallel.m_unparsed);
+    for (size_t i = 0; i < serial.m_levels.size(); ++i) {
+        EXPECT_EQ(2 * serial.m_levels[i], parallel.m_levels[i]);
+    }
+    ASSERT_EQ(serial.m_sites.size(), parallel.m_sites.size());
+    for (const auto& site : serial.m_sites) {
+        EXPECT_EQ(2 * site.second[kError], parallel.m_sites[site.first][kError])
+            << site.first;
+    }
+    ASSERT_EQ(serial.m_buckets.size(), parallel.m_buckets.size());
+    for (const auto& bucket : serial.m_buckets) {
+        EXPECT_EQ(2 * bucket.second[kInfo],
+                  parallel.m_buckets[bucket.first][kInfo]);
+    }
+
+    EXPECT_FALSE(Log::CollectLogStats({"missing_log_stats_test.log"}, parser,
+                                      1, parallel, error));
+    EXPECT_FALSE(error.empty());
+}
+
+}  // namespace Log_Test
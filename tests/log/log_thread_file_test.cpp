@@ -0,0 +1,198 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_context.h"
+#include "log/log_thread_file.h"
+#include "log/logger.h"
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+constexpr char kBaseName[] = "log_thread_file_test.log";
+
+std::string ReadFile(const std::string& file_name) {
+    std::ifstream file(file_name.c_str(), std::ios::binary);
+    std::ostringstream data;
+    data << file.rdbuf();
+    return data.str();
+}
+
+}  // namespace
+
+TEST(LogThreadFile_Test, StampsAndParsesEntries) {
+    std::string file_name = Log::ThreadFileName(kBaseName, "stamps");
+    std::remove(file_name.c_str());
+    {
+        Log::LogThreadFile_C file(file_name);
+        ASSERT_TRUE(file.IsOpen());
+        file.Write(1000, "first\n", 6, false);
+        // A message spanning two lines stays one entry
+        file.Write(2000, "second\nline\n", 12, false);
+    }
+    std::string data = ReadFile(file_name);
+    EXPECT_EQ("1000 0 6 first\n2000 1 12 second\nline\n", data);
+
+    size_t offset = 0;
+    Log::LogThreadFileRecord_TP record;
+    ASSERT_TRUE(Log::ParseThreadFileRecord(data, offset, record));
+    EXPECT_EQ(1000, record.m_time_ns);
+    EXPECT_EQ(0u, record.m_sequence);
+    EXPECT_EQ("first\n", record.m_entry);
+    ASSERT_TRUE(Log::ParseThreadFileRecord(data, offset, record));
+    EXPECT_EQ(1u, record.m_sequence);
+    EXPECT_EQ("second\nline\n", record.m_entry);
+    EXPECT_FALSE(Log::ParseThreadFileRecord(data, offset, record));
+    EXPECT_EQ(data.size(), offset);
+
+    // Cut in the middle of the last entry
+    offset = 0;
+    std::string truncated = data.substr(0, data.size() - 3);
+    ASSERT_TRUE(Log::ParseThreadFileRecord(truncated, offset, record));
+    EXPECT_FALSE(Log::ParseThreadFileRecord(truncated, offset, record));
+    std::remove(file_name.c_str());
+}
+
+TEST(LogThreadFile_Test, MergesThreadFilesInTimeOrder) {
+    constexpr int kThreads = 4;
+    constexpr int kMessages = 500;
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+    logger->SetFlushLevel(Log::LogSeverityLevel_TP::LOG_FATAL);
+    logger->SetFormat("%S");
+    logger->ClearSiteRules();
+    logger->EnablePerThreadFiles(kBaseName);
+
+    std::mutex mutex;
+    std::vector<std::string> file_names;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                file_names.push_back(Log::ThreadFileName(
+                    kBaseName, Log::LogContext_C::GetThreadId()));
+            }
+            for (int i = 0; i < kMessages; ++i) {
+                SN_LOG_INFO << t << ' ' << i;
+            }
+        });
+    }
+    // Each thread writes its file when it exits
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    logger->DisablePerThreadFiles();
+    logger->SetConfig(saved);
+
+    std::ostringstream merged;
+    std::string error;
+    EXPECT_EQ(static_cast<uint64_t>(kThreads * kMessages),
+              Log::MergeThreadFiles(file_names, merged, true, error));
+    EXPECT_EQ("", error);
+
+    std::string data = merged.str();
+    size_t offset = 0;
+    Log::LogThreadFileRecord_TP record;
+    int64_t last_time = 0;
+    std::vector<int> next(kThreads, 0);
+    int count = 0;
+    while (Log::ParseThreadFileRecord(data, offset, record)) {
+        EXPECT_LE(last_time, record.m_time_ns);
+        last_time = record.m_time_ns;
+        std::istringstream entry{std::string(record.m_entry)};
+        int thread = -1;
+        int message = -1;
+        entry >> thread >> message;
+        ASSERT_GE(thread, 0);
+        ASSERT_LT(thread, kThreads);
+        size_t index = static_cast<size_t>(thread);
+        // The order within a thread survives the merge
+        EXPECT_EQ(next[index]++, message);
+        EXPECT_EQ(static_cast<uint64_t>(message), record.m_sequence);
+        ++count;
+    }
+    EXPECT_EQ(kThreads * kMessages, count);
+
+    for (const std::string& file_name : file_names) {
+        std::remove(file_name.c_str());
+    }
+}
+
+TEST(LogThreadFile_Test, SyncWritesFilesOfOtherThreads) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+    logger->SetFlushLevel(Log::LogSeverityLevel_TP::LOG_FATAL);
+    logger->SetFormat("%S");
+    logger->ClearSiteRules();
+    logger->EnablePerThreadFiles(kBaseName);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::string file_name;
+    bool logged = false;
+    bool done = false;
+    // Keeps its entries buffered until it is told to exit
+    std::thread thread([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        file_name = Log::ThreadFileName(kBaseName,
+                                        Log::LogContext_C::GetThreadId());
+        std::remove(file_name.c_str());
+        SN_LOG_INFO << "buffered";
+        logged = true;
+        changed.notify_all();
+        changed.wait(lock, [&] { return done; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return logged; });
+    }
+    EXPECT_EQ("", ReadFile(file_name));
+    EXPECT_TRUE(logger->Sync(std::chrono::milliseconds(5000)));
+    EXPECT_NE(std::string::npos, ReadFile(file_name).find("buffered\n"));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    changed.notify_all();
+    thread.join();
+    logger->DisablePerThreadFiles();
+    logger->SetConfig(saved);
+    std::remove(file_name.c_str());
+}
+
+}  // namespace Log_Test
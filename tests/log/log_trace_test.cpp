@@ -0,0 +1,85 @@
+/* ---------------------------------------------------------------------
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the Apache License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the Apache License 2.0 for more details.
+ *
+ * You should have received a copy of the Apache License
+ * along with this program.  If not, see
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Copyright (C) 2021 Ajeet Singh Yadav [ er.ajeetsinghyadav@gmail.com ]
+ *
+ * Author:    Ajeet Singh Yadav
+ * Created:   OCT-2026
+ *
+ * Autodoc:   yes
+ * ----------------------------------------------------------------------
+ */
+
+#include "log/log_trace.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace SN;
+
+namespace Log_Test {
+namespace {
+
+size_t CountOf(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(LogTrace_Test, WritesSpansOfEveryThread) {
+    Log::Tracer_C* tracer = Log::Tracer_C::GetInstance();
+    tracer->Enable();
+    {
+        SN_TRACE_SCOPE("trace_test_outer");
+        std::thread([] { SN_TRACE_SCOPE("trace_test_worker"); }).join();
+        SN_TRACE_EVENT("trace_test_\"quoted\"");
+    }
+    tracer->Disable();
+    {
+        SN_TRACE_SCOPE("trace_test_disabled");
+    }
+
+    std::ostringstream stream;
+    tracer->WriteChromeTrace(stream);
+    std::string trace = stream.str();
+    EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+    EXPECT_EQ(1u, CountOf(trace, "\"trace_test_outer\",\"cat\":\"supernova\","
+                                 "\"ph\":\"X\""));
+    EXPECT_EQ(1u, CountOf(trace, "\"trace_test_worker\""));
+    EXPECT_EQ(1u, CountOf(trace, "\"trace_test_\\\"quoted\\\"\",\"cat\":"
+                                 "\"supernova\",\"ph\":\"i\""));
+    EXPECT_EQ(0u, CountOf(trace, "trace_test_disabled"));
+}
+
+TEST(LogTrace_Test, DropsEventsBeyondCapacity) {
+    Log::Tracer_C* tracer = Log::Tracer_C::GetInstance();
+    tracer->SetCapacity(0);
+    uint64_t dropped = tracer->GetDroppedCount();
+    tracer->Enable();
+    // A new thread needs a chunk, which the capacity no longer allows
+    std::thread([] { SN_TRACE_EVENT("trace_test_dropped"); }).join();
+    tracer->Disable();
+    tracer->SetCapacity(1 << 20);
+    EXPECT_EQ(dropped + 1, tracer->GetDroppedCount());
+}
+
+}  // namespace Log_Test
@@ -25,7 +25,14 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 using namespace SN;
 
@@ -75,8 +82,6 @@ TEST(Logger_Test, CanPrintLogLevelFatal) {
 TEST(DISABLED_Logger_Test, WhenLogLevelIsUnknown) {
     std::ostringstream stream;
     Log::LogSeverityLevel_TP level = static_cast<Log::LogSeverityLevel_TP>(6);
-    typedef std::underlying_type<Log::LogSeverityLevel_TP>::type
-        LogSeverityLevel_TP;
     stream << level;
     EXPECT_EQ("??", stream.str());
 }
@@ -104,14 +109,229 @@ TEST(Logger_Test, SetTimeStamp) {
 
 TEST(Logger_Test, CanCreateInstance) {
     Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    EXPECT_NE(nullptr, logger);
     // logger->Log(Log::LogSeverityLevel_TP::LOG_INFO, "This is Info.");
     // EXPECT_EQ("", logger->Log(Log::LogSeverityLevel_TP::LOG_INFO, "This is
     // Info."));
 }
 
+TEST(Logger_Test, WritesFormattedEntry) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    std::ostringstream stream;
+    Log::LogType_TP log_type = logger->GetConfig().m_log_type;
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->SetFormat("[%L] %P:%C %S");
+    SN_LOG_WARN << "value " << 42;
+    logger->SetFormat("[%T] [%F:%C %P] [%L] :: %S");
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, std::cerr);
+    logger->SetLogType(log_type);
+    EXPECT_EQ("[WARN] TestBody:" + std::to_string(__LINE__ - 4) + " value 42\n",
+              stream.str());
+}
+
+TEST(Logger_Test, PreparedThreadLogsWithoutAllocating) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    std::ostringstream stream;
+    Log::LogType_TP log_type = logger->GetConfig().m_log_type;
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->Prepare();
+    int64_t allocated = -1;
+    std::thread worker([logger, &allocated] {
+        logger->PrepareThread(8);
+        Log::LogRecordPool_C* pool = Log::LogRecordPool_C::GetInstance();
+        int64_t before = pool->GetStats().m_allocated;
+        SN_LOG_WARN << "first " << 1;
+        allocated = pool->GetStats().m_allocated - before;
+    });
+    worker.join();
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, std::cerr);
+    logger->SetLogType(log_type);
+    EXPECT_EQ(0, allocated);
+    EXPECT_NE(std::string::npos, stream.str().find("first 1"));
+}
+
+TEST(Logger_Test, LogsBinaryDataUpToBlobLimit) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    std::ostringstream stream;
+    Log::LogType_TP log_type = logger->GetConfig().m_log_type;
+    std::string format = logger->GetFormat();
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->SetFormat("%S");
+    logger->SetBlobLimit(4);
+    const uint8_t frame[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab};
+    SN_LOG_HEX(Log::LogSeverityLevel_TP::LOG_WARN, frame, sizeof(frame))
+        << " id " << 7;
+    SN_LOG_BASE64(Log::LogSeverityLevel_TP::LOG_WARN, frame, 3);
+    logger->SetBlobLimit(256);
+    logger->SetFormat(format);
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, std::cerr);
+    logger->SetLogType(log_type);
+    EXPECT_EQ("01234567...(+2 bytes) id 7\nASNF\n", stream.str());
+}
+
+TEST(Logger_Test, SyncPersistsEarlierRecords) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    const char* file_name = "logger_test_sync.txt";
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->SetFlushLevel(Log::LogSeverityLevel_TP::LOG_FATAL);
+    logger->SetFormat("%S");
+    logger->Init(file_name);
+    auto lines = [file_name] {
+        std::ifstream file(file_name);
+        std::string line;
+        size_t count = 0;
+        while (std::getline(file, line)) {
+            ++count;
+        }
+        return count;
+    };
+
+    SN_LOG_WARN << "sync " << 0;
+    EXPECT_TRUE(logger->Sync(std::chrono::milliseconds(5000)));
+    EXPECT_EQ(1u, lines());
+
+    logger->EnableAsyncLogging(64);
+    for (int i = 1; i <= 20; ++i) {
+        SN_LOG_WARN << "async " << i;
+    }
+    std::future<bool> synced = logger->SyncAsync();
+    SN_LOG_WARN << "after the barrier";
+    EXPECT_TRUE(synced.get());
+    EXPECT_GE(lines(), 21u);
+    logger->DisableAsyncLogging();
+
+    logger->SetConfig(saved);
+    std::remove(file_name);
+}
+
+TEST(Logger_Test, SyncFollowsRenamedLogFile) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    const char* file_name = "logger_test_sync_rename.txt";
+    const char* rotated_name = "logger_test_sync_rename.txt.1";
+    logger->SetLogType(Log::LogType_TP::FILE_LOG);
+    logger->Init(file_name);
+    SN_LOG_WARN << "before the rename";
+    // E.g. log rotation, the logger keeps writing the renamed file
+    ASSERT_EQ(0, std::rename(file_name, rotated_name));
+    SN_LOG_WARN << "after the rename";
+    EXPECT_TRUE(logger->Sync(std::chrono::milliseconds(5000)));
+    EXPECT_FALSE(std::ifstream(file_name).is_open());
+
+    logger->SetConfig(saved);
+    std::remove(rotated_name);
+}
+
+TEST(Logger_Test, SiteRulesOverrideTheGlobalLevel) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    std::ostringstream stream;
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_DEBUG, stream);
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_INFO, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_INFO);
+    logger->SetFormat("%L %S");
+    const int first_line = __LINE__ + 4;
+    auto log = [](int pass) {
+        for (int site = 0; site < 2; ++site) {
+            if (site == 0) {
+                SN_LOG_DEBUG << "first " << pass;
+            } else {
+                SN_LOG_DEBUG << "second " << pass;
+            }
+        }
+        SN_LOG_INFO << "info " << pass;
+    };
+    log(0);
+    ASSERT_TRUE(logger->AddSiteRule(
+        "logger_test.cpp:" + std::to_string(first_line),
+        Log::LogSeverityLevel_TP::LOG_DEBUG));
+    log(1);
+    ASSERT_TRUE(logger->AddSiteRule("logger_test.cpp@operator()",
+                                    Log::LogSeverityLevel_TP::LOG_WARN));
+    EXPECT_FALSE(logger->AddSiteRule("logger_test.cpp:x",
+                                     Log::LogSeverityLevel_TP::LOG_WARN));
+    log(2);
+    logger->ClearSiteRules();
+    log(3);
+
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_DEBUG, std::cout);
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_INFO, std::cout);
+    logger->SetConfig(saved);
+    EXPECT_EQ("INFO info 0\nDEBUG first 1\nINFO info 1\nINFO info 3\n",
+              stream.str());
+}
+
+namespace {
+
+/** Records how the entries arrive */
+class BatchSink_C : public Log::LogSink_C {
+   public:
+    void Write(const Log::LogRecord_TP&, const char*, size_t) override {
+        ++m_writes;
+    }
+    void WriteBatch(const Log::LogEntryBatch_TP& batch) override {
+        m_batches.push_back(batch.m_count);
+        m_data.append(batch.m_data, batch.m_size);
+    }
+
+    int m_writes = 0;
+    std::vector<size_t> m_batches;
+    std::string m_data;
+};
+
+}  // namespace
+
+TEST(Logger_Test, WritesCallerBuiltRecordsInOneBatch) {
+    Log::Logger_C* logger = Log::Logger_C::GetInstance();
+    Log::LogConfig_TP saved = logger->GetConfig();
+    std::ostringstream stream;
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, stream);
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_ERROR, stream);
+    logger->SetLogType(Log::LogType_TP::CONSOLE_LOG);
+    logger->SetLogSeverityLevel(Log::LogSeverityLevel_TP::LOG_WARN);
+    logger->SetTimeStampMode(Log::TimeStampMode_TP::EPOCH_MILLI_SECONDS);
+    logger->SetFormat("%T %F:%C %L %S");
+    auto sink = std::make_shared<BatchSink_C>();
+    logger->AddSink(sink);
+
+    std::vector<Log::LogRecord_TP> records(3);
+    const Log::LogSeverityLevel_TP levels[] = {
+        Log::LogSeverityLevel_TP::LOG_WARN, Log::LogSeverityLevel_TP::LOG_INFO,
+        Log::LogSeverityLevel_TP::LOG_ERROR};
+    for (size_t i = 0; i < records.size(); ++i) {
+        records[i].m_level = levels[i];
+        records[i].m_file = "controller.c";
+        records[i].m_line = static_cast<uint32_t>(10 + i);
+        records[i].m_message = "replayed";
+        records[i].m_time =
+            Log::LogTimePoint_TP::FromEpochNs(1700000000123456789 +
+                                              static_cast<int64_t>(i));
+    }
+    logger->WriteBatch(records.data(), records.size());
+
+    logger->RemoveSink(sink);
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_WARN, std::cerr);
+    logger->SetStream(Log::LogSeverityLevel_TP::LOG_ERROR, std::cerr);
+    logger->SetConfig(saved);
+    std::string expected =
+        "1700000000123 controller.c:10 WARN replayed\n"
+        "1700000000123 controller.c:12 ERROR replayed\n";
+    EXPECT_EQ(expected, stream.str());
+    EXPECT_EQ(0, sink->m_writes);
+    ASSERT_EQ(1u, sink->m_batches.size());
+    EXPECT_EQ(2u, sink->m_batches[0]);
+    EXPECT_EQ(expected, sink->m_data);
+}
+
 TEST(Logger_DeathTest, assertionTest) {
     GTEST_SKIP() << "skipping assertion test.";
-    int test_val = 5;
+    // Unused when SN_ASSERT is compiled out
+    [[maybe_unused]] int test_val = 5;
     SN_ASSERT(test_val < 0, "Value should not be less than zero.");
 }
 